@@ -2,10 +2,13 @@
 #define RLGAMES_AGENT_BASE
 
 #include <cassert>
+#include <vector>
 
 #include <type_alias.h>
 #include <types.h>
 
+namespace s = std;
+
 namespace rlgames {
 
 template <typename Board, typename GameState, typename Sub>
@@ -24,10 +27,13 @@ struct IsPointAnEye {
 };
 
 template <ubyte SZ> struct GoBoard;
+template <ubyte SZ> struct GoChainBoard;
+template <ubyte SZ> struct GoBitBoard;
 
-template <ubyte SZ>
-struct IsPointAnEye<GoBoard<SZ>> {
-  bool operator()(const GoBoard<SZ>& board, Pt pt, Player player){
+//eye test shared by all go board layouts
+template <typename Board>
+struct IsPointAGoEye {
+  bool operator()(const Board& board, Pt pt, Player player){
     assert(board.is_on_grid(pt));
 
     //if point is not empty, it's not an eye
@@ -56,6 +62,81 @@ struct IsPointAnEye<GoBoard<SZ>> {
   }
 };
 
+//padded board layout, border cells have color code 0 so neighbour and
+//corner tests need no bound check
+template <ubyte SZ>
+struct IsPointAnEye<GoBoard<SZ>> {
+  bool operator()(const GoBoard<SZ>& board, Pt pt, Player player){
+    using Grid = PaddedGrid<SZ>;
+    assert(board.is_on_grid(pt));
+
+    uint p = padded_index<SZ>(pt);
+    ubyte color = (ubyte)player;
+    if (board.color_code(p) != (ubyte)Player::Unknown) return false;
+
+    //all adjacent points must be friendly or off board
+    bool enclosed = true;
+    for (sint offset : Grid::NEIGHBOURS){
+      ubyte code = board.color_code(p + offset);
+      enclosed &= (code == 0U) | (code == color);
+    }
+    if (not enclosed) return false;
+
+    uint friendly_corner_count = 0;
+    uint off_board_count = 0;
+    for (sint offset : Grid::CORNERS){
+      ubyte code = board.color_code(p + offset);
+      friendly_corner_count += code == color;
+      off_board_count       += code == 0U;
+    }
+    if (off_board_count > 0)
+      return off_board_count + friendly_corner_count == 4;
+    else
+      return friendly_corner_count >= 3;
+  }
+};
+
+template <ubyte SZ>
+struct IsPointAnEye<GoChainBoard<SZ>> : IsPointAGoEye<GoChainBoard<SZ>> {};
+
+template <ubyte SZ>
+struct IsPointAnEye<GoBitBoard<SZ>> : IsPointAGoEye<GoBitBoard<SZ>> {};
+
+//undo records of the moves applied on one tree descent, so a search walks a
+//single state down and back up instead of copying the root state for every
+//descent. the records are kept between descents to reuse their buffers
+template <typename GameState>
+class UndoStack {
+  s::vector<typename GameState::Undo> mRecords;
+  size_t                              mSize;
+public:
+  UndoStack(): mSize(0) {}
+
+  void apply_move(GameState& state, Move move){
+    if (mSize == mRecords.size())
+      mRecords.emplace_back();
+    state.apply_move(move, mRecords[mSize++]);
+  }
+  //takes back every move applied since the last unwind
+  void unwind(GameState& state){
+    while (mSize > 0)
+      state.undo_move(mRecords[--mSize]);
+  }
+};
+
+//whether two game states show the same stones with the same player to move,
+//used to check a kept search tree against the state it is asked about
+template <typename GameState>
+bool is_same_position(const GameState& a, const GameState& b){
+  if (a.next_player() != b.next_player() || a.previous_move() != b.previous_move()) return false;
+  ubyte sz = a.board().size();
+  for (ubyte r = 0; r < sz; ++r)
+    for (ubyte c = 0; c < sz; ++c)
+      if (a.board().get(Pt(r, c)) != b.board().get(Pt(r, c)))
+        return false;
+  return true;
+}
+
 } // rlgames
 
 #endif//RLGAMES_AGENT_BASE
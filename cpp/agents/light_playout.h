@@ -0,0 +1,208 @@
+#ifndef RLGAMES_LIGHT_PLAYOUT
+#define RLGAMES_LIGHT_PLAYOUT
+
+#include <cassert>
+#include <array>
+#include <optional>
+#include <utility>
+
+#include <type_alias.h>
+#include <types.h>
+#include <agents/agent_base.h>
+
+namespace s = std;
+
+namespace rlgames {
+
+template <ubyte SZ, typename Board> struct GoGameState;
+template <ubyte SZ, typename Board> struct GoAreaScore;
+template <ubyte SZ> constexpr float default_komi();
+
+//uniform random number in [0, range) without a division on the common path,
+//Lemire's multiply and shift with rejection of the biased low products
+template <typename RGen>
+uint bounded_rand(RGen& gen, uint range){
+  assert(range > 0);
+
+  uint64 m = (uint64)(uint)gen() * range;
+  uint low = (uint)m;
+  if (low < range){
+    uint threshold = (0U - range) % range;
+    while (low < threshold){
+      m = (uint64)(uint)gen() * range;
+      low = (uint)m;
+    }
+  }
+  return (uint)(m >> 32);
+}
+
+//empty points of a board kept in a list. a move is drawn by swap remove over
+//the candidates, a rejected point is swapped behind them for the rest of the
+//move and a played point leaves the list
+template <typename Board>
+class EmptyPoints {
+  s::array<udyte, Board::IZ> mPoints;
+  uint                       mSize;
+public:
+  EmptyPoints(): mSize(0) {}
+
+  uint size() const { return mSize; }
+
+  void collect(const Board& board){
+    mSize = 0;
+    for (uint i = 0; i < Board::IZ; ++i)
+      if (board.get(point<Board::SIZE>(i)) == Player::Unknown)
+        mPoints[mSize++] = i;
+  }
+  //index of the first point of the list accept takes, or Board::IZ if it
+  //takes none. the taken point is removed from the list
+  template <typename RGen, typename Accept>
+  uint draw(RGen& gen, Accept accept){
+    uint candidates = mSize;
+    while (candidates > 0){
+      uint i = bounded_rand(gen, candidates);
+      uint idx = mPoints[i];
+      if (accept(idx)){
+        mPoints[i] = mPoints[--mSize];
+        return idx;
+      }
+      s::swap(mPoints[i], mPoints[--candidates]);
+    }
+    return Board::IZ;
+  }
+};
+
+//bit per on grid neighbour of pt holding a stone of player
+template <typename Board>
+uint neighbour_mask(const Board& board, Pt pt, Player player){
+  uint ret = 0, k = 0;
+  for (Pt neighbour : neighbours(pt)){
+    if (not board.is_on_grid(neighbour)) continue;
+    if (board.get(neighbour) == player)
+      ret |= 1U << k;
+    k++;
+  }
+  return ret;
+}
+
+//random playout engine, plays a game to the end with uniformly random moves
+//that do not fill the player's own eye and returns the winner. a player
+//without a move passes. on_move(player, index) sees every stone played. the
+//general engine is for games whose stones stay on the board, go captures
+//are handled by the specialization below
+template <typename Board, typename GameState>
+class LightPlayout {
+  GameState          mState;
+  EmptyPoints<Board> mEmpty;
+public:
+  template <typename RGen, typename OnMove>
+  Player play(const GameState& state, RGen& gen, OnMove on_move){
+    IsPointAnEye<Board> is_point_an_eye;
+    mState = state;
+    mEmpty.collect(mState.board());
+    while (not mState.is_over()){
+      Player player = mState.next_player();
+      uint idx = mEmpty.draw(gen, [&](uint i){
+        Pt pt = point<Board::SIZE>(i);
+        return (not is_point_an_eye(mState.board(), pt, player)) && mState.is_valid_move(Move(M::Play, pt));
+      });
+      if (idx == Board::IZ){
+        mState.apply_move(Move(M::Pass));
+        continue;
+      }
+      on_move(player, idx);
+      mState.apply_move(Move(M::Play, point<Board::SIZE>(idx)));
+    }
+    return mState.winner();
+  }
+  template <typename RGen>
+  Player play(const GameState& state, RGen& gen){
+    return play(state, gen, [](Player, uint){});
+  }
+};
+
+//go playouts run on a copy of the board alone, so no game state or position
+//history is copied or grown. a move is legal if its point is empty, it does
+//not fill the player's own eye, is not a self capture and does not retake a
+//simple ko. positional superko is not checked, a playout is cut after
+//MAX_MOVES moves in case a long cycle comes up
+template <ubyte SZ, typename Board>
+class LightPlayout<Board, GoGameState<SZ, Board>> {
+  static constexpr uint IZ = SZ * SZ;
+  static constexpr uint MAX_MOVES = IZ * 3;
+
+  Board              mBoard;
+  EmptyPoints<Board> mEmpty;
+
+  //point the opponent cannot retake after player captured at pt, a single
+  //stone capturing a single stone and left with that point as its only
+  //liberty
+  s::optional<Pt> ko_after(Pt pt, Player player, uint captured, uint empties_before){
+    if (captured == 0U || mEmpty.size() != empties_before) return s::nullopt;
+    s::optional<Pt> ret;
+    uint k = 0;
+    for (Pt neighbour : neighbours(pt)){
+      if (not mBoard.is_on_grid(neighbour)) continue;
+      Player color = mBoard.get(neighbour);
+      if (captured & (1U << k++)){
+        if (color == Player::Unknown){
+          if (ret) return s::nullopt;
+          ret = neighbour;
+        }
+      } else if (color != other_player(player))
+        return s::nullopt;
+    }
+    return ret;
+  }
+public:
+  template <typename RGen, typename OnMove>
+  Player play(const GoGameState<SZ, Board>& state, RGen& gen, OnMove on_move){
+    if (state.is_over()){
+      GoGameState<SZ, Board> copy = state;
+      return copy.winner();
+    }
+
+    IsPointAnEye<Board> is_point_an_eye;
+    mBoard = state.board();
+    mEmpty.collect(mBoard);
+    Player player = state.next_player();
+    s::optional<Pt> ko = state.ko_point();
+    uint passes = state.previous_move().mty == M::Pass ? 1U : 0U;
+    for (uint moves = 0; passes < 2 && moves < MAX_MOVES; ++moves){
+      uint idx = mEmpty.draw(gen, [&](uint i){
+        Pt pt = point<SZ>(i);
+        return (not (ko && *ko == pt)) &&
+               (not is_point_an_eye(mBoard, pt, player)) &&
+               (not mBoard.is_self_capture(player, pt));
+      });
+      if (idx == IZ){
+        passes++;
+        ko.reset();
+      } else {
+        Pt pt = point<SZ>(idx);
+        uint opponents = neighbour_mask(mBoard, pt, other_player(player));
+        on_move(player, idx);
+        mBoard.place_stone(player, pt);
+        passes = 0;
+        ko.reset();
+        uint captured = opponents & ~neighbour_mask(mBoard, pt, other_player(player));
+        if (captured != 0U){
+          uint empties_before = mEmpty.size() + 1;
+          mEmpty.collect(mBoard);
+          ko = ko_after(pt, player, captured, empties_before);
+        }
+      }
+      player = other_player(player);
+    }
+    GoAreaScore<SZ, Board> scorer(mBoard, default_komi<SZ>());
+    return scorer.winner();
+  }
+  template <typename RGen>
+  Player play(const GoGameState<SZ, Board>& state, RGen& gen){
+    return play(state, gen, [](Player, uint){});
+  }
+};
+
+} // rlgames
+
+#endif//RLGAMES_LIGHT_PLAYOUT
@@ -6,66 +6,116 @@
 #include <ctime>
 #include <cmath>
 #include <random>
-#include <set>
+#include <array>
 #include <vector>
 #include <algorithm>
 #include <thread>
-#include <future>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 #include <type_alias.h>
 #include <types.h>
 #include <bag.h>
+#include <node_pool.h>
 #include <agents/agent_base.h>
+#include <agents/search_budget.h>
+#include <agents/light_playout.h>
 
 namespace s = std;
 
 namespace rlgames {
 
-//TODO: find faster method than keep doing modulo for random number generation
-
-//Leaf parallel MCTS algorithm, leaf parallel meaning we do MCTS rollouts in parallel
+//Leaf parallel MCTS algorithm, leaf parallel meaning we do MCTS rollouts in parallel.
+//rollouts run on a pool of worker threads that live as long as the agent, the
+//rollouts of a leaf are claimed one at a time from an atomic counter by the
+//workers and the calling thread, and the calling thread waits for every
+//worker to check in before summing their scores
 template <typename RGen, typename Board, typename GameState>
 struct LPMCTSAgent : AgentBase<Board, GameState, LPMCTSAgent<RGen, Board, GameState>> {
   static constexpr float MIN_SCORE = -10.F;
   static constexpr float MAX_SCORE =  10.F;
   static constexpr float TIE_SCORE =  0.F;
 private:
-  size_t mMaxExpand;
-  float  mEFactor;
-  size_t mMCBatchSize;
-  size_t mNumThreads;
+  //per thread rollout state, kept between leaves
+  struct Worker {
+    RGen                           gen;
+    LightPlayout<Board, GameState> playout;
+    float                          score;
+
+    explicit Worker(uint seed): gen(seed), score(TIE_SCORE) {}
+  };
+
+  SearchBudget            mBudget;
+  float                   mEFactor;
+  size_t                  mMCBatchSize;
+  size_t                  mNumThreads;
+  RGen                    mGen;
+  s::vector<Worker>       mWorkers;     //one per thread, the last one is the calling thread
+  s::vector<s::thread>    mThreads;
+  s::mutex                mMutex;
+  s::condition_variable   mWake;
+  uint64                  mGeneration;  //bumped for every leaf, guarded by mMutex
+  bool                    mStop;        //guarded by mMutex
+  const GameState*        mLeaf;
+  s::atomic<size_t>       mPending;     //rollouts of the current leaf not yet claimed
+  s::atomic<size_t>       mBusy;        //workers not done with the current leaf
 protected:
-  float batch_mc_play(const GameState& gs, size_t bsize){
-    RGen gen(rand());
-    size_t sz = gs.board().size();
-    s::vector<udyte> cache(sz * sz);
-    s::iota(cache.begin(), cache.end(), 0);
-    IsPointAnEye<Board> is_point_an_eye;
-    float score = TIE_SCORE;
-    for (size_t i = 0; i < bsize; ++i){
-      GameState play_state = gs;
-      while (not play_state.is_over()){
-        s::random_shuffle(s::begin(cache), s::end(cache), [&gen](int k){return gen() % k;});
-        bool found_move = false;
-        for (udyte index : cache){
-          Pt pt = point<Board::SIZE>(index);
-          Move m(M::Play, pt);
-          if (play_state.is_valid_move(m) && (not is_point_an_eye(play_state.board(), pt, play_state.next_player()))){
-            play_state.apply_move(m);
-            found_move = true;
-            break;
-          }
-        }
-        if (not found_move)
-          play_state.apply_move(Move(M::Pass));
-      }
-      switch (play_state.winner()){
-      case Player::Black:   score += MAX_SCORE; break;
-      case Player::White:   score += MIN_SCORE; break;
-      case Player::Unknown: score += TIE_SCORE; break;
+  struct MCTSNode;
+
+  node_pool<MCTSNode>     mPool;        //storage reused by every select_move
+
+  bool claim_rollout(){
+    size_t pending = mPending.load(s::memory_order_relaxed);
+    while (pending > 0)
+      if (mPending.compare_exchange_weak(pending, pending - 1, s::memory_order_relaxed))
+        return true;
+    return false;
+  }
+
+  void run_rollouts(Worker& worker){
+    worker.score = TIE_SCORE;
+    while (claim_rollout()){
+      switch (worker.playout.play(*mLeaf, worker.gen)){
+      case Player::Black:   worker.score += MAX_SCORE; break;
+      case Player::White:   worker.score += MIN_SCORE; break;
+      case Player::Unknown: worker.score += TIE_SCORE; break;
       default: assert(false);
       }
     }
+  }
+
+  void worker_loop(Worker& worker){
+    uint64 seen = 0;
+    while (true){
+      {
+        s::unique_lock<s::mutex> lock(mMutex);
+        mWake.wait(lock, [this, &seen]{ return mStop || mGeneration != seen; });
+        if (mStop) return;
+        seen = mGeneration;
+      }
+      run_rollouts(worker);
+      mBusy.fetch_sub(1, s::memory_order_release);
+    }
+  }
+
+  //total score of mMCBatchSize rollouts from gs, shared by all threads
+  float batch_mc_play(const GameState& gs){
+    mLeaf = &gs;
+    mPending.store(mMCBatchSize, s::memory_order_relaxed);
+    mBusy.store(mThreads.size(), s::memory_order_relaxed);
+    {
+      s::lock_guard<s::mutex> lock(mMutex);
+      mGeneration++;
+    }
+    mWake.notify_all();
+    run_rollouts(mWorkers.back());
+    while (mBusy.load(s::memory_order_acquire) > 0)
+      s::this_thread::yield();
+
+    float score = TIE_SCORE;
+    for (const Worker& worker : mWorkers)
+      score += worker.score;
     return score;
   }
 
@@ -85,158 +135,208 @@ protected:
     }
   }
 
-  struct MCTSNode {
-    GameState            gs;
-    MCTSNode*            parent;
-    float                qvalue;
-    size_t               ncount;
-    bag<Move>            unp_children; //unexplored children, initially all legal moves
-    s::vector<MCTSNode*> children;     //all expanded children
-    //TODO: maybe a better container, DenseSet ?
-    s::set<MCTSNode*>    ptn_children; //all expanded children that has unexplored children
-
-    MCTSNode() = default;
-    explicit MCTSNode(GameState&& gsr, MCTSNode* parent = nullptr):
-      gs(s::move(gsr)), parent(parent), qvalue(0.), ncount(0) {
-      unp_children = gs.legal_moves();
-    }
-    MCTSNode(MCTSNode&& o) noexcept :
-      gs(s::move(o.gs)), parent(o.parent), qvalue(o.qvalue), ncount(o.ncount), unp_children(s::move(o.unp_children)), children(s::move(o.children)), ptn_children(s::move(o.ptn_children)) {}
-    MCTSNode& operator=(MCTSNode&& o) noexcept {
-      gs = s::move(o.gs);
-      parent = o.parent;
-      qvalue = o.qvalue;
-      ncount = o.ncount;
-      unp_children = s::move(o.unp_children);
-      children = s::move(o.children);
-      ptn_children = s::move(o.ptn_children);
-      return *this;
-    }
+  //every point, pass and resign
+  static constexpr size_t MAX_EDGES = Board::IZ + 2;
 
-    void update_new_child_state(MCTSNode* node, size_t index){
-      assert(node != nullptr);
+  //a move out of a node together with the statistics of the child it leads to
+  struct Edge {
+    MCTSNode* child;
+    float     qvalue;
+    uint      ncount;
+    Pt        pt;
+    M         mty;
+    bool      exhausted; //child is terminal or has no edge left to explore
 
-      unp_children.pop(index);
-      children.push_back(node);
+    Edge() = default;
+    explicit Edge(const Move& m): child(nullptr), qvalue(0.F), ncount(0U), pt(m.mpt), mty(m.mty), exhausted(false) {}
 
-      if (not node->gs.is_over()){
-        ptn_children.insert(node);
-      } else if (parent && unp_children.size() == 0 && ptn_children.size() == 0){
-        parent->remove_child(this);
-      }
+    Move move() const {
+      if (mty == M::Play) return Move(mty, pt);
+      else                return Move(mty);
     }
-    void remove_child(MCTSNode* node){
-      assert(node != nullptr);
+  };
 
-      ptn_children.erase(node);
-      if (parent && unp_children.size() == 0 && ptn_children.size() == 0)
-        parent->remove_child(this);
-    }
-    void update(float qv, size_t cnt){
-      qvalue += qv;
-      ncount += cnt;
-      if (parent)
-        parent->update(qv, cnt);
+  //edges [0, nexpanded) have a child, the rest are unexplored moves. selection
+  //scans the expanded edges in place without touching the children. a node
+  //keeps no game state, its state is the root state with the moves on the
+  //path to it replayed
+  struct MCTSNode {
+    MCTSNode*                  parent;
+    uint                       pedge;     //index of the edge from parent to here
+    size_t                     ncount;
+    uint                       nexpanded;
+    uint                       nlive;     //edges not exhausted, expanded or not
+    Player                     player;    //next player of the node's state
+    fixed_bag<Edge, MAX_EDGES> edges;
+
+    explicit MCTSNode(const GameState& gs, MCTSNode* parent = nullptr, uint pedge = 0):
+      parent(parent), pedge(pedge), ncount(0), nexpanded(0), player(gs.next_player()) {
+      for (const Move& move : gs.legal_moves())
+        edges.push_back(Edge(move));
+      nlive = edges.size();
     }
-  };
 
-  template <typename T>
-  struct BufferAllocator {
-    size_t       index;
-    s::vector<T> objects;
+    bool has_unexplored() const { return nexpanded < edges.size(); }
+    //moves the unexplored edge at index to the end of the expanded edges
+    uint expand(uint index){
+      assert(index >= nexpanded && index < edges.size());
 
-    explicit BufferAllocator(size_t sz): index(0U) {
-      objects.resize(sz);
+      s::swap(edges[index], edges[nexpanded]);
+      return nexpanded++;
     }
-    T* allocate(T&& obj) noexcept {
-      assert(index < objects.size());
+    void set_child(uint edge, MCTSNode* child, bool terminal){
+      assert(child != nullptr);
 
-      objects[index] = s::move(obj);
-      size_t prev_index = index;
-      index++;
-      return &objects[prev_index];
+      edges[edge].child = child;
+      if (terminal)
+        exhaust(edge);
+    }
+    void exhaust(uint edge){
+      edges[edge].exhausted = true;
+      nlive--;
+      if (parent && nlive == 0)
+        parent->exhaust(pedge);
+    }
+    void update(float qv, size_t cnt){
+      ncount += cnt;
+      if (parent){
+        Edge& edge = parent->edges[pedge];
+        edge.qvalue += qv;
+        edge.ncount += cnt;
+        parent->update(qv, cnt);
+      }
     }
   };
 
-  MCTSNode* recursive_uct(MCTSNode* node, BufferAllocator<MCTSNode>& arena){
-    if (node->unp_children.size() > 0){
-      uint rand_idx = s::rand() % node->unp_children.size();
-      GameState new_state = node->gs;
-      new_state.apply_move(node->unp_children[rand_idx]);
-      MCTSNode* new_node = arena.allocate(MCTSNode(s::move(new_state), node));
-      node->update_new_child_state(new_node, rand_idx);
+  //state is the state of node and follows the descent, it is the state of
+  //the returned node. the moves applied are recorded in undo
+  MCTSNode* recursive_uct(MCTSNode* node, GameState& state, UndoStack<GameState>& undo, node_pool<MCTSNode>& arena){
+    if (node->has_unexplored()){
+      uint edge = node->expand(node->nexpanded + bounded_rand(mGen, node->edges.size() - node->nexpanded));
+      undo.apply_move(state, node->edges[edge].move());
+      MCTSNode* new_node = arena.construct(state, node, edge);
+      node->set_child(edge, new_node, state.is_over());
       return new_node;
     } else {
-      s::vector<MCTSNode*> best_children;
-      float best_score = init_best_score(node->gs.next_player());
-      for (decltype(s::begin(node->ptn_children)) it = s::begin(node->ptn_children); it != s::end(node->ptn_children); ++it){
-        float score = (*it)->qvalue / (float)(*it)->ncount;
-        float explore_factor = mEFactor * s::sqrt(2 * s::log((float)node->ncount / (float)(*it)->ncount));
-        if ((*it)->gs.next_player() == Player::Black)
+      s::array<MCTSNode*, MAX_EDGES> best_children;
+      uint nbest = 0;
+      Player player = node->player;
+      float best_score = init_best_score(player);
+      for (uint i = 0; i < node->nexpanded; ++i){
+        const Edge& edge = node->edges[i];
+        if (edge.exhausted) continue;
+
+        float score = edge.qvalue / (float)edge.ncount;
+        float explore_factor = mEFactor * s::sqrt(2 * s::log((float)node->ncount / (float)edge.ncount));
+        if (player == Player::Black)
           score += explore_factor;
         else
           score -= explore_factor;
-        if (is_improvement(score, best_score, node->gs.next_player())){
+        if (is_improvement(score, best_score, player)){
           best_score = score;
-          best_children.clear();
-          best_children.push_back(*it);
+          nbest = 0;
+          best_children[nbest++] = edge.child;
         } else if (score == best_score)
-          best_children.push_back(*it);
+          best_children[nbest++] = edge.child;
       }
-      if (best_children.size() > 0){
-        uint random_choice = s::rand() % best_children.size();
-        return recursive_uct(best_children[random_choice], arena);
+      if (nbest > 0){
+        MCTSNode* child = best_children[bounded_rand(mGen, nbest)];
+        undo.apply_move(state, node->edges[child->pedge].move());
+        return recursive_uct(child, state, undo, arena);
       } else
         return nullptr;
     }
   }
+  //every root move is explored, the most visited one also scores best and
+  //no other can catch up on visits with the iterations left
+  bool is_decided(MCTSNode* root, const SearchClock& clock){
+    if (root->nexpanded == 0 || root->has_unexplored()) return false;
+
+    Player player = root->player;
+    uint first = 0;
+    size_t second = 0;
+    for (uint i = 1; i < root->nexpanded; ++i)
+      if (root->edges[i].ncount > root->edges[first].ncount){
+        second = root->edges[first].ncount;
+        first = i;
+      } else
+        second = s::max<size_t>(second, root->edges[i].ncount);
+    float first_score = root->edges[first].qvalue / (float)root->edges[first].ncount;
+    for (uint i = 0; i < root->nexpanded; ++i)
+      if (is_improvement(root->edges[i].qvalue / (float)root->edges[i].ncount, first_score, player))
+        return false;
+    return clock.decided(root->edges[first].ncount, second, mMCBatchSize);
+  }
 public:
-  LPMCTSAgent(size_t max_expansion, float exploration_factor, size_t mc_sample_size = 1):
-    mMaxExpand(max_expansion), mEFactor(exploration_factor), mMCBatchSize(mc_sample_size), mNumThreads(s::thread::hardware_concurrency()) {
+  LPMCTSAgent(size_t max_expansion, float exploration_factor, size_t mc_sample_size = 1, size_t num_threads = s::thread::hardware_concurrency()):
+    mBudget(max_expansion), mEFactor(exploration_factor), mMCBatchSize(mc_sample_size), mNumThreads(num_threads),
+    mGeneration(0), mStop(false), mLeaf(nullptr), mPending(0U), mBusy(0U) {
     s::srand(unsigned(s::time(0)));
+    mGen = RGen(rand());
     if (mNumThreads == 0U)
       mNumThreads = 1U;
+    mWorkers.reserve(mNumThreads);
+    for (size_t i = 0; i < mNumThreads; ++i)
+      mWorkers.emplace_back(mGen());
+    mThreads.reserve(mNumThreads - 1);
+    for (size_t i = 0; i + 1 < mNumThreads; ++i)
+      mThreads.emplace_back(&LPMCTSAgent::worker_loop, this, s::ref(mWorkers[i]));
+  }
+  LPMCTSAgent(const LPMCTSAgent&) = delete;
+  LPMCTSAgent& operator=(const LPMCTSAgent&) = delete;
+  ~LPMCTSAgent(){
+    {
+      s::lock_guard<s::mutex> lock(mMutex);
+      mStop = true;
+    }
+    mWake.notify_all();
+    for (s::thread& thread : mThreads)
+      thread.join();
+  }
+
+  //limit later searches by time and node count instead of max_expansion
+  void set_budget(const SearchBudget& budget){
+    assert(budget.nodes > 0);
+
+    mBudget = budget;
   }
 
   Move select_move(GameState& gs){
-    GameState gs_copy = gs; //explicit copy to reduce total copying
-    BufferAllocator<MCTSNode> arena(mMaxExpand + 1);
-    MCTSNode* root = arena.allocate(MCTSNode(s::move(gs_copy)));
+    mPool.reset();
+    mPool.reserve(mBudget.nodes + 1);
+    node_pool<MCTSNode>& arena = mPool;
+    MCTSNode* root = arena.construct(gs);
 
     assert(root != nullptr);
 
-    for (size_t i = 0; i < mMaxExpand; ++i){
-      MCTSNode* node = recursive_uct(root, arena);
+    SearchClock clock(mBudget);
+    GameState state = gs;
+    UndoStack<GameState> undo;
+    while (clock.next()){
+      MCTSNode* node = recursive_uct(root, state, undo, arena);
       if (node == nullptr) break;
 
-      size_t pbatchsize = (mMCBatchSize + 1U) / mNumThreads;
-      size_t total_size = pbatchsize * mNumThreads;
-
-      s::vector<s::future<float>> futures;
-      futures.reserve(mNumThreads);
-      for (size_t i = 0; i < mNumThreads; ++i)
-        futures.push_back(s::async(s::launch::async, &LPMCTSAgent::batch_mc_play, this, node->gs, pbatchsize));
-
-      float qvalue = 0.f;
-      for (auto& fut : futures)
-        qvalue += fut.get();
-      node->update(qvalue, total_size);
+      float qvalue = batch_mc_play(state);
+      undo.unwind(state);
+      node->update(qvalue, mMCBatchSize);
+      if (clock.checkpoint() && is_decided(root, clock)) break;
     }
 
-    float best_score = init_best_score(root->gs.next_player());
-    s::vector<MCTSNode*> best_nodes;
-    for (MCTSNode* child : root->children){
-      float score = child->qvalue / (float)child->ncount;
-      if (is_improvement(score, best_score, root->gs.next_player())){
+    float best_score = init_best_score(root->player);
+    s::vector<Move> best_moves;
+    for (uint i = 0; i < root->nexpanded; ++i){
+      const Edge& edge = root->edges[i];
+      float score = edge.qvalue / (float)edge.ncount;
+      if (is_improvement(score, best_score, root->player)){
         best_score = score;
-        best_nodes.clear();
-        best_nodes.push_back(child);
+        best_moves.clear();
+        best_moves.push_back(edge.move());
       } else if (score == best_score)
-        best_nodes.push_back(child);
+        best_moves.push_back(edge.move());
     }
-    if (best_nodes.size() > 0){
-      uint choice = s::rand() % best_nodes.size();
-      return best_nodes[choice]->gs.previous_move();
+    if (best_moves.size() > 0){
+      uint choice = bounded_rand(mGen, best_moves.size());
+      return best_moves[choice];
     } else
       return Move(M::Pass);
   }
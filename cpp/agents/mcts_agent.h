@@ -6,64 +6,111 @@
 #include <ctime>
 #include <cmath>
 #include <random>
-#include <set>
+#include <array>
 #include <vector>
 #include <algorithm>
+#include <thread>
+#include <atomic>
+#include <memory>
 
 #include <type_alias.h>
 #include <types.h>
 #include <bag.h>
+#include <node_pool.h>
 #include <agents/agent_base.h>
+#include <agents/search_budget.h>
+#include <agents/light_playout.h>
 
 namespace s = std;
 
 namespace rlgames {
 
-//TODO: find faster method than keep doing modulo for random number generation
-
 template <typename RGen, typename Board, typename GameState>
 struct MCTSAgent : AgentBase<Board, GameState, MCTSAgent<RGen, Board, GameState>> {
   static constexpr float MIN_SCORE = -10.F;
   static constexpr float MAX_SCORE =  10.F;
   static constexpr float TIE_SCORE =  0.F;
 private:
-  size_t mMaxExpand;
-  float  mEFactor;
-  size_t mMCBatchSize;
-  s::vector<udyte> mCache;
-  RGen   mGen;
+  SearchBudget     mBudget;
+  float            mEFactor;
+  size_t           mMCBatchSize;
+  size_t           mNumTrees;
+  RGen             mGen;
+  s::thread        mPonder;
+  s::atomic<bool>  mStopPonder;
+  float            mRaveK;      //playouts at which rave and uct weigh the same, 0 disables rave
 protected:
-  void initialize_cache(size_t sz){
-    mCache.resize(sz);
-    s::iota(mCache.begin(), mCache.end(), 0);
-  }
+  struct MCTSNode;
+  using Playout = LightPlayout<Board, GameState>;
+
+  //all moves as first statistics of the playouts from one leaf, indexed by
+  //player and point. the player who first played a point in a playout gets
+  //that playout's result for the point
+  struct AMAF {
+    s::array<float,  2 * Board::IZ> qvalue;
+    s::array<uint,   2 * Board::IZ> ncount;
+    s::array<Player, Board::IZ>     first; //first player on each point in the current playout
+
+    static uint key(Player player, uint idx){
+      return (player == Player::Black ? 0U : Board::IZ) + idx;
+    }
+    void clear(){
+      qvalue.fill(0.F);
+      ncount.fill(0U);
+    }
+    void start_playout(){
+      first.fill(Player::Unknown);
+    }
+    void play(Player player, uint idx){
+      if (first[idx] == Player::Unknown)
+        first[idx] = player;
+    }
+    void end_playout(float result){
+      for (uint i = 0; i < Board::IZ; ++i)
+        if (first[i] != Player::Unknown){
+          qvalue[key(first[i], i)] += result;
+          ncount[key(first[i], i)] += 1;
+        }
+    }
+    //a move in the tree comes before every move of the playouts
+    void play_first(Player player, uint idx, float qv, uint cnt){
+      qvalue[key(player, idx)] = qv;
+      ncount[key(player, idx)] = cnt;
+      qvalue[key(other_player(player), idx)] = 0.F;
+      ncount[key(other_player(player), idx)] = 0U;
+    }
+  };
+  AMAF                mAmaf;
 
-  float mc_play(GameState& gs){
-    IsPointAnEye<Board> is_point_an_eye;
+  //nodes of the tree kept from the last select_move of single tree search,
+  //the spare pool receives the reused subtree on the next call
+  node_pool<MCTSNode> mPool;
+  node_pool<MCTSNode> mSpare;
+  MCTSNode*           mRoot = nullptr;
+  GameState           mRootState;
+
+  Playout             mPlayout;
+
+  //amaf collects the moves of the playouts when it is not null
+  float mc_play(const GameState& gs, RGen& gen, Playout& playout, AMAF* amaf){
     float score = TIE_SCORE;
+    if (amaf) amaf->clear();
     for (size_t i = 0; i < mMCBatchSize; ++i){
-      GameState play_state = gs;
-      while (not play_state.is_over()){
-        s::random_shuffle(s::begin(mCache), s::end(mCache), [this](int k){ return this->mGen() % k; });
-        bool found_move = false;
-        for (udyte index : mCache){
-          Pt pt = point<Board::SIZE>(index);
-          Move m(M::Play, pt);
-          if (play_state.is_valid_move(m) && (not is_point_an_eye(play_state.board(), pt, play_state.next_player()))){
-            play_state.apply_move(m);
-            found_move = true;
-            break;
-          }
-        }
-        if (not found_move)
-          play_state.apply_move(Move(M::Pass));
-      }
-      switch (play_state.winner()){
-      case Player::Black:   score += MAX_SCORE; break;
-      case Player::White:   score += MIN_SCORE; break;
-      case Player::Unknown: score += TIE_SCORE; break;
+      Player winner;
+      if (amaf){
+        amaf->start_playout();
+        winner = playout.play(gs, gen, [amaf](Player player, uint idx){ amaf->play(player, idx); });
+      } else
+        winner = playout.play(gs, gen);
+      float result = TIE_SCORE;
+      switch (winner){
+      case Player::Black:   result = MAX_SCORE; break;
+      case Player::White:   result = MIN_SCORE; break;
+      case Player::Unknown: result = TIE_SCORE; break;
       default: assert(false);
       }
+      score += result;
+      if (amaf) amaf->end_playout(result);
     }
     return score;
   }
@@ -84,150 +131,398 @@ protected:
     }
   }
 
+  //every point, pass and resign
+  static constexpr size_t MAX_EDGES = Board::IZ + 2;
+
+  //a move out of a node together with the statistics of the child it leads to
+  //and the rave statistics of the move
+  struct Edge {
+    MCTSNode* child;
+    float     qvalue;
+    uint      ncount;
+    float     rvalue;
+    uint      rcount;
+    Pt        pt;
+    M         mty;
+    bool      exhausted; //child is terminal or has no edge left to explore
+
+    Edge() = default;
+    explicit Edge(const Move& m): child(nullptr), qvalue(0.F), ncount(0U), rvalue(0.F), rcount(0U), pt(m.mpt), mty(m.mty), exhausted(false) {}
+
+    Move move() const {
+      if (mty == M::Play) return Move(mty, pt);
+      else                return Move(mty);
+    }
+  };
+
+  //edges [0, nexpanded) have a child, the rest are unexplored moves. selection
+  //scans the expanded edges in place without touching the children. a node
+  //keeps no game state, its state is the root state with the moves on the
+  //path to it replayed
   struct MCTSNode {
-    GameState            gs;
-    MCTSNode*            parent;
-    float                qvalue;
-    size_t               ncount;
-    bag<Move>            unp_children; //unexplored children, initially all legal moves
-    s::vector<MCTSNode*> children;     //all expanded children
-    //TODO: maybe a better container, DenseSet ?
-    s::set<MCTSNode*>    ptn_children; //all expanded children that has unexplored children
-
-    MCTSNode() = default;
-    explicit MCTSNode(GameState&& gsr, MCTSNode* parent = nullptr):
-      gs(s::move(gsr)), parent(parent), qvalue(0.), ncount(0) {
-      unp_children = gs.legal_moves();
-    }
-    MCTSNode(MCTSNode&& o) noexcept :
-      gs(s::move(o.gs)), parent(o.parent), qvalue(o.qvalue), ncount(o.ncount), unp_children(s::move(o.unp_children)), children(s::move(o.children)), ptn_children(s::move(o.ptn_children)) {}
-    MCTSNode& operator=(MCTSNode&& o) noexcept {
-      gs = s::move(o.gs);
-      parent = o.parent;
-      qvalue = o.qvalue;
-      ncount = o.ncount;
-      unp_children = s::move(o.unp_children);
-      children = s::move(o.children);
-      ptn_children = s::move(o.ptn_children);
-      return *this;
-    }
-
-    void update_new_child_state(MCTSNode* node, size_t index){
-      assert(node != nullptr);
-
-      unp_children.pop(index);
-      children.push_back(node);
-
-      if (not node->gs.is_over()){
-        ptn_children.insert(node);
-      } else if (parent && unp_children.size() == 0 && ptn_children.size() == 0){
-        parent->remove_child(this);
-      }
+    MCTSNode*                  parent;
+    uint                       pedge;     //index of the edge from parent to here
+    size_t                     ncount;
+    uint                       nexpanded;
+    uint                       nlive;     //edges not exhausted, expanded or not
+    Player                     player;    //next player of the node's state
+    fixed_bag<Edge, MAX_EDGES> edges;
+
+    explicit MCTSNode(const GameState& gs, MCTSNode* parent = nullptr, uint pedge = 0):
+      parent(parent), pedge(pedge), ncount(0), nexpanded(0), player(gs.next_player()) {
+      for (const Move& move : gs.legal_moves())
+        edges.push_back(Edge(move));
+      nlive = edges.size();
+    }
+
+    bool has_unexplored() const { return nexpanded < edges.size(); }
+    //moves the unexplored edge at index to the end of the expanded edges
+    uint expand(uint index){
+      assert(index >= nexpanded && index < edges.size());
+
+      s::swap(edges[index], edges[nexpanded]);
+      return nexpanded++;
     }
-    void remove_child(MCTSNode* node){
-      assert(node != nullptr);
+    void set_child(uint edge, MCTSNode* child, bool terminal){
+      assert(child != nullptr);
 
-      ptn_children.erase(node);
-      if (parent && unp_children.size() == 0 && ptn_children.size() == 0)
-        parent->remove_child(this);
+      edges[edge].child = child;
+      if (terminal)
+        exhaust(edge);
+    }
+    void exhaust(uint edge){
+      edges[edge].exhausted = true;
+      nlive--;
+      if (parent && nlive == 0)
+        parent->exhaust(pedge);
     }
     void update(float qv, size_t cnt){
-      qvalue += qv;
       ncount += cnt;
-      if (parent)
+      if (parent){
+        Edge& edge = parent->edges[pedge];
+        edge.qvalue += qv;
+        edge.ncount += cnt;
         parent->update(qv, cnt);
+      }
     }
   };
 
-  template <typename T>
-  struct BufferAllocator {
-    size_t       index;
-    s::vector<T> objects;
-
-    explicit BufferAllocator(size_t sz): index(0U) {
-      objects.resize(sz);
-    }
-    T* allocate(T&& obj) noexcept {
-      assert(index < objects.size());
+  //mean playout score of the edge, blended with its rave score when rave is
+  //on. the rave weight shrinks as the edge gets its own playouts
+  float edge_score(const Edge& edge){
+    float score = edge.qvalue / (float)edge.ncount;
+    if (mRaveK <= 0.F || edge.rcount == 0) return score;
+    float beta = s::sqrt(mRaveK / (3.F * edge.ncount + mRaveK));
+    return (1.F - beta) * score + beta * edge.rvalue / (float)edge.rcount;
+  }
 
-      objects[index] = s::move(obj);
-      size_t prev_index = index;
-      index++;
-      return &objects[prev_index];
+  //walks from the leaf up to the root, every expanded edge whose point was
+  //first played by the player choosing it below its node gets the playout
+  //results of those playouts
+  void update_amaf(MCTSNode* node, AMAF& amaf, float qvalue){
+    for (; node != nullptr; node = node->parent){
+      for (uint i = 0; i < node->nexpanded; ++i){
+        Edge& edge = node->edges[i];
+        if (edge.mty != M::Play) continue;
+        uint key = AMAF::key(node->player, index<Board::SIZE>(edge.pt));
+        edge.rvalue += amaf.qvalue[key];
+        edge.rcount += amaf.ncount[key];
+      }
+      if (node->parent){
+        const Edge& in = node->parent->edges[node->pedge];
+        if (in.mty == M::Play)
+          amaf.play_first(node->parent->player, index<Board::SIZE>(in.pt), qvalue, mMCBatchSize);
+      }
     }
-  };
+  }
 
-  MCTSNode* recursive_uct(MCTSNode* node, BufferAllocator<MCTSNode>& arena){
-    if (node->unp_children.size() > 0){
-      uint rand_idx = mGen() % node->unp_children.size();
-      GameState new_state = node->gs;
-      new_state.apply_move(node->unp_children[rand_idx]);
-      MCTSNode* new_node = arena.allocate(MCTSNode(s::move(new_state), node));
-      node->update_new_child_state(new_node, rand_idx);
+  //state is the state of node and follows the descent, it is the state of
+  //the returned node. the moves applied are recorded in undo
+  MCTSNode* recursive_uct(MCTSNode* node, GameState& state, UndoStack<GameState>& undo, node_pool<MCTSNode>& arena, RGen& gen){
+    if (node->has_unexplored()){
+      uint edge = node->expand(node->nexpanded + bounded_rand(gen, node->edges.size() - node->nexpanded));
+      undo.apply_move(state, node->edges[edge].move());
+      MCTSNode* new_node = arena.construct(state, node, edge);
+      node->set_child(edge, new_node, state.is_over());
       return new_node;
     } else {
-      s::vector<MCTSNode*> best_children;
-      float best_score = init_best_score(node->gs.next_player());
-      for (decltype(s::begin(node->ptn_children)) it = s::begin(node->ptn_children); it != s::end(node->ptn_children); ++it){
-        float score = (*it)->qvalue / (float)(*it)->ncount;
-        float explore_factor = mEFactor * s::sqrt(2 * s::log((float)node->ncount / (float)(*it)->ncount));
-        if ((*it)->gs.next_player() == Player::Black)
+      s::array<MCTSNode*, MAX_EDGES> best_children;
+      uint nbest = 0;
+      Player player = node->player;
+      float best_score = init_best_score(player);
+      for (uint i = 0; i < node->nexpanded; ++i){
+        const Edge& edge = node->edges[i];
+        if (edge.exhausted) continue;
+
+        float score = edge_score(edge);
+        float explore_factor = mEFactor * s::sqrt(2 * s::log((float)node->ncount / (float)edge.ncount));
+        if (player == Player::Black)
           score += explore_factor;
         else
           score -= explore_factor;
-        if (is_improvement(score, best_score, node->gs.next_player())){
+        if (is_improvement(score, best_score, player)){
           best_score = score;
-          best_children.clear();
-          best_children.push_back(*it);
+          nbest = 0;
+          best_children[nbest++] = edge.child;
         } else if (score == best_score)
-          best_children.push_back(*it);
+          best_children[nbest++] = edge.child;
       }
-      if (best_children.size() > 0){
-        uint random_choice = mGen() % best_children.size();
-        return recursive_uct(best_children[random_choice], arena);
+      if (nbest > 0){
+        MCTSNode* child = best_children[bounded_rand(gen, nbest)];
+        undo.apply_move(state, node->edges[child->pedge].move());
+        return recursive_uct(child, state, undo, arena, gen);
       } else
         return nullptr;
     }
   }
-public:
-  MCTSAgent(size_t max_expansion, float exploration_factor, size_t mc_sample_size = 1):
-    mMaxExpand(max_expansion), mEFactor(exploration_factor), mMCBatchSize(mc_sample_size) {
-    s::srand(unsigned(s::time(0)));
-    mGen = RGen(rand());
+
+  //statistics of one move at the root, summed over all trees
+  struct RootStat {
+    Move   move;
+    float  qvalue;
+    size_t ncount;
+
+    RootStat(Move m, float qv, size_t cnt): move(m), qvalue(qv), ncount(cnt) {}
+  };
+
+  size_t subtree_size(MCTSNode* node){
+    size_t ret = 1;
+    for (uint i = 0; i < node->nexpanded; ++i)
+      ret += subtree_size(node->edges[i].child);
+    return ret;
   }
 
-  Move select_move(const GameState& gs){
-    GameState gs_copy = gs; //explicit copy to reduce total copying
-    if (mCache.size() == 0){
-      size_t sz = gs_copy.board().size();
-      initialize_cache(sz * sz);
+  //moves the subtree into arena, nodes left behind in the old arena are
+  //unreachable and go away when it is reset
+  MCTSNode* move_subtree(MCTSNode* node, MCTSNode* parent, node_pool<MCTSNode>& arena){
+    MCTSNode* ret = arena.construct(s::move(*node));
+    ret->parent = parent;
+    for (uint i = 0; i < ret->nexpanded; ++i)
+      ret->edges[i].child = move_subtree(ret->edges[i].child, ret, arena);
+    return ret;
+  }
+
+  //node of the kept tree showing gs, it is the root or a node up to two
+  //moves below it, nullptr if gs was not reached through the kept tree. the
+  //last move of gs is the move into the node, so only states along it are
+  //replayed
+  MCTSNode* find_kept_node(const GameState& gs){
+    if (mRoot == nullptr) return nullptr;
+    if (is_same_position(mRootState, gs)) return mRoot;
+    Move last = gs.previous_move();
+    for (uint i = 0; i < mRoot->nexpanded; ++i){
+      const Edge& edge = mRoot->edges[i];
+      if (edge.move() == last){
+        GameState child_gs = mRootState;
+        child_gs.apply_move(last);
+        if (is_same_position(child_gs, gs)) return edge.child;
+      }
+      for (uint j = 0; j < edge.child->nexpanded; ++j){
+        const Edge& grand = edge.child->edges[j];
+        if (not (grand.move() == last)) continue;
+        GameState grandchild_gs = mRootState;
+        grandchild_gs.apply_move(edge.move());
+        grandchild_gs.apply_move(last);
+        if (is_same_position(grandchild_gs, gs)) return grand.child;
+      }
     }
-    BufferAllocator<MCTSNode> arena(mMaxExpand + 1);
-    MCTSNode* root = arena.allocate(MCTSNode(s::move(gs_copy)));
+    return nullptr;
+  }
+
+  //root for a search of gs with room for expansions more nodes, reusing the
+  //matching subtree of the kept tree with its statistics
+  MCTSNode* prepare_root(const GameState& gs, size_t expansions){
+    MCTSNode* kept = find_kept_node(gs);
+    size_t kept_size = kept != nullptr ? subtree_size(kept) : 0U;
+    mSpare.reset();
+    mSpare.reserve(kept_size + expansions + 1);
+    if (kept != nullptr)
+      mRoot = move_subtree(kept, nullptr, mSpare);
+    else
+      mRoot = mSpare.construct(gs);
+    s::swap(mPool, mSpare);
+    mSpare.reset();
+    mRootState = gs;
+    return mRoot;
+  }
+
+  //every root move is explored, the most visited one also scores best unless
+  //rave picks by visits, and no other can catch up on visits with the
+  //iterations left
+  bool is_decided(MCTSNode* root, const SearchClock& clock){
+    if (root->nexpanded == 0 || root->has_unexplored()) return false;
+
+    Player player = root->player;
+    uint first = 0;
+    size_t second = 0;
+    for (uint i = 1; i < root->nexpanded; ++i)
+      if (root->edges[i].ncount > root->edges[first].ncount){
+        second = root->edges[first].ncount;
+        first = i;
+      } else
+        second = s::max<size_t>(second, root->edges[i].ncount);
+    float first_score = root->edges[first].qvalue / (float)root->edges[first].ncount;
+    for (uint i = 0; i < root->nexpanded && mRaveK <= 0.F; ++i)
+      if (is_improvement(root->edges[i].qvalue / (float)root->edges[i].ncount, first_score, player))
+        return false;
+    return clock.decided(root->edges[first].ncount, second, mMCBatchSize);
+  }
+
+  //grow one tree from gs with its own arena and generator, returns the
+  //statistics of the root children
+  s::vector<RootStat> build_tree(const GameState& gs, const SearchBudget& budget, RGen& gen, Playout& playout, AMAF& amaf){
+    node_pool<MCTSNode> arena(budget.nodes + 1);
+    MCTSNode* root = arena.construct(gs);
+    return grow_tree(root, gs, arena, budget, gen, playout, amaf);
+  }
 
+  //root_state is the state of root
+  s::vector<RootStat> grow_tree(MCTSNode* root, const GameState& root_state, node_pool<MCTSNode>& arena, const SearchBudget& budget, RGen& gen, Playout& playout, AMAF& amaf){
     assert(root != nullptr);
 
-    for (size_t i = 0; i < mMaxExpand; ++i){
-      MCTSNode* node = recursive_uct(root, arena);
+    SearchClock clock(budget);
+    GameState state = root_state;
+    UndoStack<GameState> undo;
+    while (clock.next() && not mStopPonder.load(s::memory_order_relaxed)){
+      MCTSNode* node = recursive_uct(root, state, undo, arena, gen);
       if (node == nullptr) break;
 
-      float qvalue = mc_play(node->gs);
+      float qvalue = mc_play(state, gen, playout, mRaveK > 0.F ? &amaf : nullptr);
+      undo.unwind(state);
       node->update(qvalue, mMCBatchSize);
+      if (mRaveK > 0.F)
+        update_amaf(node, amaf, qvalue);
+      if (clock.checkpoint() && is_decided(root, clock)) break;
+    }
+    s::vector<RootStat> ret;
+    ret.reserve(root->nexpanded);
+    for (uint i = 0; i < root->nexpanded; ++i)
+      ret.emplace_back(root->edges[i].move(), root->edges[i].qvalue, root->edges[i].ncount);
+    return ret;
+  }
+
+  //root parallel search, each thread grows an independent tree with no
+  //synchronization and the root children are merged by move at the end. the
+  //node budget is split among the trees, the time budget applies to each
+  s::vector<RootStat> build_trees(const GameState& gs){
+    SearchBudget budget = mBudget;
+    budget.nodes = (mBudget.nodes + mNumTrees - 1) / mNumTrees;
+    s::vector<s::vector<RootStat>> stats(mNumTrees);
+    s::vector<s::thread> workers;
+    workers.reserve(mNumTrees);
+    for (size_t i = 0; i < mNumTrees; ++i)
+      workers.emplace_back([this, &gs, &stats, &budget, i](uint seed){
+        RGen gen(seed);
+        Playout playout;
+        s::unique_ptr<AMAF> amaf(new AMAF);
+        stats[i] = this->build_tree(gs, budget, gen, playout, *amaf);
+      }, (uint)mGen());
+    for (s::thread& worker : workers)
+      worker.join();
+
+    s::vector<RootStat> ret = s::move(stats[0]);
+    for (size_t i = 1; i < mNumTrees; ++i)
+      for (const RootStat& stat : stats[i]){
+        decltype(s::begin(ret)) it = s::find_if(s::begin(ret), s::end(ret), [&stat](const RootStat& o){ return o.move == stat.move; });
+        if (it == s::end(ret))
+          ret.push_back(stat);
+        else {
+          it->qvalue += stat.qvalue;
+          it->ncount += stat.ncount;
+        }
+      }
+    return ret;
+  }
+public:
+  //num_trees > 1 enables root parallel search with one tree per thread, the
+  //expansions are split evenly among the trees. single tree search keeps its
+  //tree and continues from the matching subtree on the next call
+  MCTSAgent(size_t max_expansion, float exploration_factor, size_t mc_sample_size = 1, size_t num_trees = 1):
+    mBudget(max_expansion), mEFactor(exploration_factor), mMCBatchSize(mc_sample_size), mNumTrees(num_trees), mStopPonder(false), mRaveK(0.F) {
+    s::srand(unsigned(s::time(0)));
+    mGen = RGen(rand());
+    if (mNumTrees == 0U)
+      mNumTrees = 1U;
+  }
+  ~MCTSAgent(){
+    stop_pondering();
+  }
+
+  //keep growing the single search tree from gs, the position after the
+  //agent's own move, on a background thread until the next select_move, which
+  //finds the opponent's move among the children of the pondered tree. at most
+  //one node budget is spent pondering. root parallel search keeps no tree and
+  //does not ponder. the agent must not be used while pondering except for
+  //select_move and stop_pondering
+  void start_pondering(const GameState& gs){
+    stop_pondering();
+    if (mNumTrees > 1 || gs.is_over()) return;
+
+    MCTSNode* root = prepare_root(gs, mBudget.nodes);
+    mPonder = s::thread([this, root]{
+      grow_tree(root, mRootState, mPool, SearchBudget(mBudget.nodes), mGen, mPlayout, mAmaf);
+    });
+  }
+  void stop_pondering(){
+    if (not mPonder.joinable()) return;
+    mStopPonder.store(true, s::memory_order_relaxed);
+    mPonder.join();
+    mStopPonder.store(false, s::memory_order_relaxed);
+  }
+
+  //blend all moves as first statistics of the playouts into the uct score,
+  //equivalence is the number of playouts of a move at which its own mean
+  //and its rave mean weigh the same, 0 turns rave off
+  void set_rave(float equivalence){
+    mRaveK = equivalence;
+  }
+
+  //limit later searches by time and node count instead of max_expansion
+  void set_budget(const SearchBudget& budget){
+    assert(budget.nodes > 0);
+
+    mBudget = budget;
+  }
+
+  Move select_move(const GameState& gs){
+    stop_pondering();
+    s::vector<RootStat> stats;
+    if (mNumTrees > 1)
+      stats = build_trees(gs);
+    else {
+      MCTSNode* root = prepare_root(gs, mBudget.nodes);
+      stats = grow_tree(root, mRootState, mPool, mBudget, mGen, mPlayout, mAmaf);
+    }
+
+    s::vector<Move> best_moves;
+    if (mRaveK > 0.F){
+      //rave leaves most moves with a playout or two and a noisy mean, the most
+      //visited move is the robust choice there
+      size_t best_count = 0;
+      for (const RootStat& stat : stats){
+        if (stat.ncount > best_count){
+          best_count = stat.ncount;
+          best_moves.clear();
+          best_moves.push_back(stat.move);
+        } else if (stat.ncount == best_count && best_count > 0)
+          best_moves.push_back(stat.move);
+      }
+    } else {
+      Player player = gs.next_player();
+      float best_score = init_best_score(player);
+      for (const RootStat& stat : stats){
+        float score = stat.qvalue / (float)stat.ncount;
+        if (is_improvement(score, best_score, player)){
+          best_score = score;
+          best_moves.clear();
+          best_moves.push_back(stat.move);
+        } else if (score == best_score)
+          best_moves.push_back(stat.move);
+      }
     }
-    float best_score = init_best_score(root->gs.next_player());
-    s::vector<MCTSNode*> best_nodes;
-    for (MCTSNode* child : root->children){
-      float score = child->qvalue / (float)child->ncount;
-      if (is_improvement(score, best_score, root->gs.next_player())){
-        best_score = score;
-        best_nodes.clear();
-        best_nodes.push_back(child);
-      } else if (score == best_score)
-        best_nodes.push_back(child);
-    }
-    if (best_nodes.size() > 0){
-      uint choice = mGen() % best_nodes.size();
-      return best_nodes[choice]->gs.previous_move();
+    if (best_moves.size() > 0){
+      uint choice = bounded_rand(mGen, best_moves.size());
+      return best_moves[choice];
     } else
       return Move(M::Pass);
   }
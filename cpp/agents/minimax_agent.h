@@ -50,7 +50,8 @@ protected:
   }
 
   //TODO: make sure recursion does not build up stack
-  RRet recursive_minimax_search(const GameState& gs, size_t depth){
+  //gs is modified by apply_move and restored by undo_move before returning
+  RRet recursive_minimax_search(GameState& gs, size_t depth){
     if (gs.is_over()){
       Player winner = gs.winner();
       switch (winner){
@@ -69,14 +70,16 @@ protected:
     case Player::White: best_score = MAX_SCORE; break;
     default: assert(false);
     }
+    Player player = gs.next_player();
+    typename GameState::Undo undo;
     for (Move m : gs.legal_moves()){
-      GameState ngs = gs;
-      ngs.apply_move(m);
+      gs.apply_move(m, undo);
       size_t ndepth = depth;
-      if (ngs.next_player() == Player::Black)
+      if (gs.next_player() == Player::Black)
         ndepth--;
-      RRet val = recursive_minimax_search(ngs, ndepth);
-      if (is_improvement(val.score, best_score, gs.next_player())){
+      RRet val = recursive_minimax_search(gs, ndepth);
+      gs.undo_move(undo);
+      if (is_improvement(val.score, best_score, player)){
         best_score = val.score;
         best_moves.clear();
         best_moves.push_back(m);
@@ -110,7 +113,7 @@ protected:
    * its parent (maximizer) has higher value than the minimum value found
    * current node, we no longer need to explore downstream.
    */
-  RRet recursive_alpha_beta_minimax_search(const GameState& gs, size_t depth, float alpha, float beta){
+  RRet recursive_alpha_beta_minimax_search(GameState& gs, size_t depth, float alpha, float beta){
     if (gs.is_over()){
       Player winner = gs.winner();
       switch (winner){
@@ -129,20 +132,22 @@ protected:
     case Player::White: best_score = MAX_SCORE; break;
     default: assert(false);
     }
+    Player player = gs.next_player();
+    typename GameState::Undo undo;
     for (Move m : gs.legal_moves()){
-      if (should_prune(best_score, alpha, beta, gs.next_player()))
+      if (should_prune(best_score, alpha, beta, player))
         break;
-      GameState ngs = gs;
-      ngs.apply_move(m);
+      gs.apply_move(m, undo);
       size_t ndepth = depth;
-      if (ngs.next_player() == Player::Black)
+      if (gs.next_player() == Player::Black)
         ndepth--;
-      RRet val = recursive_alpha_beta_minimax_search(ngs, ndepth, alpha, beta);
-      if (is_improvement(val.score, best_score, gs.next_player())){
+      RRet val = recursive_alpha_beta_minimax_search(gs, ndepth, alpha, beta);
+      gs.undo_move(undo);
+      if (is_improvement(val.score, best_score, player)){
         best_score = val.score;
         best_moves.clear();
         best_moves.push_back(m);
-        switch (gs.next_player()){
+        switch (player){
         case Player::Black:
           if (best_score > alpha)
             alpha = best_score;
@@ -168,11 +173,12 @@ public:
   }
 
   Move select_move(const GameState& gs){
+    GameState state = gs; //single copy walked down and back up the search tree
     if constexpr (ABP){
-      RRet ret = recursive_alpha_beta_minimax_search(gs, mDepth, MIN_SCORE, MAX_SCORE);
+      RRet ret = recursive_alpha_beta_minimax_search(state, mDepth, MIN_SCORE, MAX_SCORE);
       return ret.move;
     } else {
-      RRet ret = recursive_minimax_search(gs, mDepth);
+      RRet ret = recursive_minimax_search(state, mDepth);
       return ret.move;
     }
   }
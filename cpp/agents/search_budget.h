@@ -0,0 +1,114 @@
+#ifndef RLGAMES_SEARCH_BUDGET
+#define RLGAMES_SEARCH_BUDGET
+
+#include <cassert>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+
+#include <type_alias.h>
+
+namespace s = std;
+
+namespace rlgames {
+
+//limits of one search, a search stops at whichever limit it hits first.
+//nodes also sizes the node storage of the tree agents so it is always set,
+//millis of 0 means no time limit. with early_stop the search also ends once
+//the most visited root child cannot be overtaken within the budget left
+struct SearchBudget {
+  size_t nodes;
+  uint   millis;
+  bool   early_stop;
+
+  explicit SearchBudget(size_t nodes, uint millis = 0, bool early_stop = false):
+    nodes(nodes), millis(millis), early_stop(early_stop) {}
+};
+
+//tracks the iterations of one search against a budget. the clock is read
+//about once a millisecond, the stride between reads is re-estimated from the
+//iteration rate seen so far, so the check costs a counter compare per
+//iteration for fast playouts and a clock read per iteration for slow ones.
+//early stop is only worth testing at the checkpoints
+class SearchClock {
+  using Clock = s::chrono::steady_clock;
+  static constexpr size_t MAX_STRIDE  = 1024;
+  static constexpr size_t NODE_STRIDE = 64;   //iterations between checkpoints without a time limit
+  static constexpr double TIME_MARGIN = 2.;   //slack on the iterations extrapolated to the deadline
+  static constexpr size_t UNKNOWN = s::numeric_limits<size_t>::max();
+
+  SearchBudget      mBudget;
+  Clock::time_point mStart;
+  Clock::time_point mDeadline;
+  size_t            mIters;
+  size_t            mNextCheck;
+  size_t            mTimeLeft;   //iterations left before the deadline, estimated at the last check
+  bool              mExpired;
+  bool              mCheckpoint; //whether the last iteration read the clock
+
+  void check(){
+    Clock::time_point now = Clock::now();
+    if (now >= mDeadline){
+      mExpired = true;
+      mTimeLeft = 0;
+      return;
+    }
+    s::chrono::nanoseconds elapsed = now - mStart;
+    s::chrono::nanoseconds left = mDeadline - now;
+    size_t stride = 1;
+    if (elapsed.count() > 0){
+      double rate = (double)mIters / (double)elapsed.count(); //per nanosecond
+      mTimeLeft = (size_t)(rate * (double)left.count() * TIME_MARGIN);
+      stride = s::clamp<size_t>((size_t)(rate * 1e6), 1U, MAX_STRIDE);
+    }
+    mNextCheck = mIters + stride;
+  }
+public:
+  explicit SearchClock(const SearchBudget& budget):
+    mBudget(budget), mStart(Clock::now()), mIters(0), mNextCheck(1), mTimeLeft(UNKNOWN), mExpired(false), mCheckpoint(false) {
+    assert(mBudget.nodes > 0);
+
+    mDeadline = mStart + s::chrono::milliseconds(mBudget.millis);
+  }
+
+  size_t iterations() const { return mIters; }
+
+  //true while another iteration fits in the budget, counts it
+  bool next(){
+    mCheckpoint = false;
+    if (mExpired || mIters >= mBudget.nodes) return false;
+    if (mIters >= mNextCheck){
+      mCheckpoint = true;
+      if (mBudget.millis > 0){
+        check();
+        if (mExpired) return false;
+      } else
+        mNextCheck = mIters + NODE_STRIDE;
+    }
+    mIters++;
+    return true;
+  }
+
+  //whether this iteration is a checkpoint, cheap points to test early stop
+  bool checkpoint() const { return mCheckpoint; }
+
+  //iterations left, limited by the node count and by the rate measured at
+  //the last clock read. the rate is only a past average and iterations can
+  //speed up, so the time term carries TIME_MARGIN times the extrapolation
+  size_t remaining() const {
+    size_t ret = mBudget.nodes - s::min(mIters, mBudget.nodes);
+    if (mBudget.millis > 0) ret = s::min(ret, mTimeLeft);
+    return ret;
+  }
+
+  //the most visited child cannot be overtaken by the runner up even if it
+  //gets every iteration left. per_iteration is the visits one iteration adds,
+  //the playouts per leaf when the counts are playouts
+  bool decided(size_t first, size_t second, size_t per_iteration = 1) const {
+    return mBudget.early_stop && first > second + remaining() * per_iteration;
+  }
+};
+
+} // rlgames
+
+#endif//RLGAMES_SEARCH_BUDGET
@@ -0,0 +1,314 @@
+#ifndef RLGAMES_TP_MCTS_AGENT
+#define RLGAMES_TP_MCTS_AGENT
+
+#include <cassert>
+#include <cstdlib>
+#include <ctime>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+
+#include <type_alias.h>
+#include <types.h>
+#include <node_pool.h>
+#include <agents/agent_base.h>
+#include <agents/search_budget.h>
+#include <agents/light_playout.h>
+
+namespace s = std;
+
+namespace rlgames {
+
+//atomic<float> has no fetch_add before C++20
+[[gnu::always_inline]] inline void atomic_add(s::atomic<float>& a, float v){
+  float expected = a.load(s::memory_order_relaxed);
+  while (not a.compare_exchange_weak(expected, expected + v, s::memory_order_relaxed));
+}
+
+//Tree parallel MCTS algorithm, all threads descend and grow the same tree.
+//node statistics are atomics, a thread adds a virtual loss to every node on
+//its path until its rollout result is backed up so other threads spread to
+//other branches, and children are expanded by claiming the next unexpanded
+//move with fetch_add then publishing the new node into its slot
+template <typename RGen, typename Board, typename GameState>
+struct TPMCTSAgent : AgentBase<Board, GameState, TPMCTSAgent<RGen, Board, GameState>> {
+  static constexpr float MIN_SCORE = -10.F;
+  static constexpr float MAX_SCORE =  10.F;
+  static constexpr float TIE_SCORE =  0.F;
+private:
+  SearchBudget mBudget;
+  float        mEFactor;
+  size_t       mMCBatchSize;
+  size_t       mNumThreads;
+  RGen         mGen;
+protected:
+  float mc_play(const GameState& gs, RGen& gen, LightPlayout<Board, GameState>& playout){
+    float score = TIE_SCORE;
+    for (size_t i = 0; i < mMCBatchSize; ++i){
+      switch (playout.play(gs, gen)){
+      case Player::Black:   score += MAX_SCORE; break;
+      case Player::White:   score += MIN_SCORE; break;
+      case Player::Unknown: score += TIE_SCORE; break;
+      default: assert(false);
+      }
+    }
+    return score;
+  }
+
+  bool is_improvement(float score, float best_score, Player player){
+    switch (player){
+    case Player::Black: return score > best_score;
+    case Player::White: return score < best_score;
+    default: assert(false);
+    }
+  }
+
+  float init_best_score(Player player){
+    switch (player){
+    case Player::Black: return MIN_SCORE;
+    case Player::White: return MAX_SCORE;
+    default: assert(false);
+    }
+  }
+
+  //score of a lost rollout for the player choosing among children
+  float loss_score(Player player){
+    switch (player){
+    case Player::Black: return MIN_SCORE;
+    case Player::White: return MAX_SCORE;
+    default: assert(false);
+    }
+  }
+
+  //every point and pass, resign is left out of the tree
+  static constexpr size_t MAX_EDGES = Board::IZ + 1;
+
+  struct MCTSNode;
+
+  //a move out of a node and the child it leads to, null until published
+  struct Edge {
+    s::atomic<MCTSNode*> child;
+    Pt                   pt;
+    M                    mty;
+
+    Move move() const {
+      if (mty == M::Play) return Move(mty, pt);
+      else                return Move(mty);
+    }
+  };
+
+  //a node keeps no game state, its state is the root state with the moves
+  //on the path to it replayed. its edges are the legal moves of that state,
+  //fixed at creation and stored inline so expanding a node allocates nothing
+  struct MCTSNode {
+    MCTSNode*                    parent;
+    s::atomic<float>             qvalue;
+    s::atomic<size_t>            ncount;
+    s::atomic<uint>              vloss;    //threads currently below this node
+    s::atomic<uint>              nclaimed; //edges claimed for expansion
+    uint                         nedges;
+    Player                       player;   //next player of the node's state
+    bool                         terminal;
+    s::array<Edge, MAX_EDGES>    edges;
+
+    MCTSNode(const GameState& gs, MCTSNode* p, uint vl):
+      parent(p), qvalue(0.F), ncount(0), vloss(vl), nclaimed(0), nedges(0), player(gs.next_player()), terminal(gs.is_over()) {
+      typename GameState::MoveMask moves = gs.legal_moves_mask();
+      for_each_set_bit(moves, [this](uint idx){
+        Edge& edge = edges[nedges++];
+        edge.child.store(nullptr, s::memory_order_relaxed);
+        if (idx < Board::IZ){
+          edge.pt = point<Board::SIZE>(idx);
+          edge.mty = M::Play;
+        } else
+          edge.mty = M::Pass;
+      });
+    }
+    //index of the next edge to expand, or nedges if all are taken
+    uint claim(){
+      if (nclaimed.load(s::memory_order_relaxed) >= nedges) return nedges;
+      return s::min<uint>(nclaimed.fetch_add(1, s::memory_order_relaxed), nedges);
+    }
+    uint num_claimed() const {
+      return s::min<uint>(nclaimed.load(s::memory_order_acquire), nedges);
+    }
+    void update(float qv, size_t cnt){
+      for (MCTSNode* node = this; node != nullptr; node = node->parent){
+        atomic_add(node->qvalue, qv);
+        node->ncount.fetch_add(cnt, s::memory_order_relaxed);
+        node->vloss.fetch_sub(1, s::memory_order_relaxed);
+      }
+    }
+    void revert(){
+      for (MCTSNode* node = this; node != nullptr; node = node->parent)
+        node->vloss.fetch_sub(1, s::memory_order_relaxed);
+    }
+  };
+
+  //storage shared by all threads and reused by every select_move, nodes are
+  //never freed during one search
+  concurrent_node_pool<MCTSNode> mPool;
+
+  //descend from root adding a virtual loss on every node visited, returns
+  //the node to roll out from, or nullptr once the pool is exhausted. state
+  //is the state of root and follows the descent, it is the state of the
+  //returned node. the moves applied are recorded in undo
+  MCTSNode* select(MCTSNode* root, GameState& state, UndoStack<GameState>& undo, RGen& gen){
+    s::array<uint, MAX_EDGES> best_edges;
+    MCTSNode* node = root;
+    while (true){
+      node->vloss.fetch_add(1, s::memory_order_relaxed);
+      if (node->terminal) return node;
+
+      uint idx = node->claim();
+      if (idx < node->nedges){
+        undo.apply_move(state, node->edges[idx].move());
+        MCTSNode* child = mPool.construct(state, node, 1U);
+        if (child == nullptr){
+          node->revert();
+          return nullptr;
+        }
+        node->edges[idx].child.store(child, s::memory_order_release);
+        return child;
+      }
+
+      Player player = node->player;
+      float vscore = loss_score(player) * mMCBatchSize;
+      size_t pcount = node->ncount.load(s::memory_order_relaxed) + node->vloss.load(s::memory_order_relaxed) * mMCBatchSize;
+      uint nbest = 0;
+      float best_score = init_best_score(player);
+      uint published = node->num_claimed();
+      for (uint i = 0; i < published; ++i){
+        MCTSNode* child = node->edges[i].child.load(s::memory_order_acquire);
+        if (child == nullptr) continue;
+
+        uint vloss = child->vloss.load(s::memory_order_relaxed);
+        size_t count = child->ncount.load(s::memory_order_relaxed) + vloss * mMCBatchSize;
+        if (count == 0) continue;
+        float score = (child->qvalue.load(s::memory_order_relaxed) + vloss * vscore) / (float)count;
+        float explore_factor = mEFactor * s::sqrt(2 * s::log((float)pcount / (float)count));
+        if (player == Player::Black)
+          score += explore_factor;
+        else
+          score -= explore_factor;
+        if (is_improvement(score, best_score, player)){
+          best_score = score;
+          nbest = 0;
+          best_edges[nbest++] = i;
+        } else if (score == best_score)
+          best_edges[nbest++] = i;
+      }
+      //children still being published by other threads, roll out from here
+      if (nbest == 0) return node;
+      const Edge& best = node->edges[best_edges[bounded_rand(gen, nbest)]];
+      undo.apply_move(state, best.move());
+      node = best.child.load(s::memory_order_relaxed);
+    }
+  }
+
+  //every root move is published, the most visited one also scores best and
+  //no other can catch up on visits with the iterations left to all threads.
+  //rollouts in flight count for the runner up through their virtual loss
+  bool is_decided(MCTSNode* root, const SearchClock& clock){
+    if (root->nedges == 0 || root->num_claimed() < root->nedges) return false;
+
+    Player player = root->player;
+    MCTSNode* first = nullptr;
+    for (uint i = 0; i < root->nedges; ++i){
+      MCTSNode* child = root->edges[i].child.load(s::memory_order_acquire);
+      if (child == nullptr || child->ncount.load(s::memory_order_relaxed) == 0) return false;
+      if (first == nullptr || child->ncount.load(s::memory_order_relaxed) > first->ncount.load(s::memory_order_relaxed))
+        first = child;
+    }
+    size_t first_count = first->ncount.load(s::memory_order_relaxed);
+    float first_score = first->qvalue.load(s::memory_order_relaxed) / (float)first_count;
+    size_t second = 0;
+    for (uint i = 0; i < root->nedges; ++i){
+      MCTSNode* child = root->edges[i].child.load(s::memory_order_relaxed);
+      if (child == first) continue;
+      size_t count = child->ncount.load(s::memory_order_relaxed);
+      if (is_improvement(child->qvalue.load(s::memory_order_relaxed) / (float)count, first_score, player))
+        return false;
+      second = s::max(second, count + child->vloss.load(s::memory_order_relaxed) * mMCBatchSize);
+    }
+    return clock.decided(first_count, second, mMCBatchSize * mNumThreads);
+  }
+
+  //each thread searches its share of the node budget under the full time
+  //budget, the first to find the root decided stops them all. a fully
+  //expanded tree keeps being searched until the budget runs out
+  void search(MCTSNode* root, const GameState& root_state, const SearchBudget& budget, s::atomic<bool>& stop, uint seed){
+    RGen gen(seed);
+    LightPlayout<Board, GameState> playout;
+    SearchClock clock(budget);
+    GameState state = root_state;
+    UndoStack<GameState> undo;
+    while (clock.next() && not stop.load(s::memory_order_relaxed)){
+      MCTSNode* node = select(root, state, undo, gen);
+      if (node == nullptr) break;
+
+      float qvalue = mc_play(state, gen, playout);
+      undo.unwind(state);
+      node->update(qvalue, mMCBatchSize);
+      if (clock.checkpoint() && is_decided(root, clock))
+        stop.store(true, s::memory_order_relaxed);
+    }
+  }
+public:
+  TPMCTSAgent(size_t max_expansion, float exploration_factor, size_t mc_sample_size = 1, size_t num_threads = s::thread::hardware_concurrency()):
+    mBudget(max_expansion), mEFactor(exploration_factor), mMCBatchSize(mc_sample_size), mNumThreads(num_threads), mGen(unsigned(s::time(0))) {
+    if (mNumThreads == 0U)
+      mNumThreads = 1U;
+  }
+
+  //limit later searches by time and node count instead of max_expansion
+  void set_budget(const SearchBudget& budget){
+    assert(budget.nodes > 0);
+
+    mBudget = budget;
+  }
+
+  Move select_move(const GameState& gs){
+    SearchBudget budget = mBudget;
+    budget.nodes = (mBudget.nodes + mNumThreads - 1) / mNumThreads;
+    mPool.reset();
+    mPool.reserve(budget.nodes * mNumThreads + 1);
+    MCTSNode* root = mPool.construct(gs, nullptr, 0U);
+
+    s::atomic<bool> stop(false);
+    s::vector<s::thread> workers;
+    workers.reserve(mNumThreads);
+    for (size_t i = 0; i < mNumThreads; ++i)
+      workers.emplace_back(&TPMCTSAgent::search, this, root, s::cref(gs), s::cref(budget), s::ref(stop), (uint)mGen());
+    for (s::thread& worker : workers)
+      worker.join();
+
+    float best_score = init_best_score(root->player);
+    s::vector<Move> best_moves;
+    for (uint i = 0; i < root->num_claimed(); ++i){
+      MCTSNode* child = root->edges[i].child.load(s::memory_order_acquire);
+      if (child == nullptr || child->ncount.load() == 0) continue;
+
+      float score = child->qvalue.load() / (float)child->ncount.load();
+      if (is_improvement(score, best_score, root->player)){
+        best_score = score;
+        best_moves.clear();
+        best_moves.push_back(root->edges[i].move());
+      } else if (score == best_score)
+        best_moves.push_back(root->edges[i].move());
+    }
+    if (best_moves.size() > 0){
+      uint choice = bounded_rand(mGen, best_moves.size());
+      return best_moves[choice];
+    } else
+      return Move(M::Pass);
+  }
+};
+
+} // rlgames
+
+#endif//RLGAMES_TP_MCTS_AGENT
@@ -2,16 +2,25 @@
 #define RLGAMES_ZERO_AGENT
 
 #include <type_alias.h>
+#include <eval_cache.h>
 #include <dirichlet_distribution.h>
 #include <models/model_base.h>
+#include <models/inference_server.h>
 #include <encoders/go_action_encoder.h>
 #include <encoders/go_zero_encoder.h>
 #include <experience/zero_episodic_buffer.h>
 #include <agents/agent_base.h>
+#include <agents/search_budget.h>
 
 #include <cassert>
 #include <array>
+#include <limits>
 #include <algorithm>
+#include <vector>
+#include <thread>
+#include <future>
+#include <optional>
+#include <atomic>
 
 #include <torch/torch.h>
 
@@ -27,143 +36,418 @@ public:
   static constexpr float MAX_SCORE =  1.F;
   static constexpr float TIE_SCORE =  0.F;
 private:
-  Model&                    mModel;
-  NoiseDist                 mNoise;
-  t::Device                 mDevice;
-  RGen                      mGen;
-  ZeroEpisodicExpCollector* mExp;
-  uint                      mMaxExpand;
-  float                     mEFactor;
-  float                     mNoiseFactor;
+  using StateEncoder = decltype(Model::state_encoder);
+
+  Model&                      mModel;
+  StateEncoder                mEncoder; //own copy, encoders keep scratch buffers
+  NoiseDist                   mNoise;
+  t::Device                   mDevice;
+  RGen                        mGen;
+  ZeroEpisodicExpCollector*   mExp;
+  SearchBudget                mBudget;
+  float                       mEFactor;
+  float                       mNoiseFactor;
+  uint                        mBatchSize;
+  EvalCache<BF>*              mCache;
+  InferenceServer<Model, BF>* mServer;
+  s::thread                   mPonder;
+  s::atomic<bool>             mStopPonder;
 protected:
-  struct Node;
+  static constexpr uint NIL = s::numeric_limits<uint>::max();
 
-  //keeps tracks the statistics of each move from some node
-  struct Branch {
+  //statistics of one legal move of a node, child is the index of the node
+  //the move leads to in the node arena, NIL until it is expanded
+  struct Edge {
     float prior;
     float total_value;
-    long  visit_count;
-    Node* child;
-    explicit Branch(float prior = 0.F, float total_value = 0, uint visit_count = 0):
+    uint  visit_count;
+    uint  child;
+    udyte midx; //array index of the move, not Move
+
+    Edge(uint midx, float prior):
       prior(prior),
-      total_value(total_value),
-      visit_count(visit_count),
-      child(nullptr)
+      total_value(0.F),
+      visit_count(0U),
+      child(NIL),
+      midx(midx)
     {}
+
+    float expected_value() const {
+      return visit_count > 0 ? total_value / (float)visit_count : 0.F;
+    }
   };
 
+  //nodes keep no game state, the state of a node is the root state with the
+  //moves on the path to it replayed. the edges of a node are the legal moves
+  //of its state, num_edges of them from first_edge in the edge arena, a
+  //terminal state has none
   struct Node {
-    GameState gs;
-    float     qvalue; //TODO: this is actually never used after node creation!
-    uint      total_count;
-    Branch    branches[BF];
-    Node*     parent;
-    uint      last_midx; //array index of the last move, not Move
-
-    Node(GameState&& gs, float qvalue, float* priors, Node* parent = nullptr, uint last_midx = BF):
-      gs(s::move(gs)),
+    float qvalue;      //value of the state for its next player, backed up on creation and terminal visits
+    uint  total_count;
+    uint  parent;      //NIL for the root
+    uint  first_edge;
+    udyte num_edges;
+    udyte parent_edge; //edge of parent leading here, numbered from its first edge
+
+    Node(float qvalue, uint parent, uint first_edge, uint parent_edge):
       qvalue(qvalue),
       total_count(1U),
       parent(parent),
-      last_midx(last_midx){
-      for (uint i = 0; i < BF; ++i)
-        branches[i].prior = priors[i];
-    }
-    Node& operator=(Node&& o){
-      gs = s::move(o.gs);
-      qvalue = o.qvalue;
-      total_count = o.total_count;
-      s::memcpy(branches, o.branches, sizeof(Branch) * BF);
-      parent = o.parent;
-      last_midx = o.last_midx;
-      return *this;
-    }
-    Node() = default;
+      first_edge(first_edge),
+      num_edges(0),
+      parent_edge(parent_edge)
+    {}
+  };
 
-    void add_child(uint midx, Node* child_node){
-      branches[midx].child = child_node;
-    }
-    bool has_child(uint midx){
-      if (midx >= BF) return false;
-      else            return branches[midx].child != nullptr;
+  //nodes and edges of the tree kept from the last select_move, the spare
+  //arenas receive the reused subtree on the next call. nodes are addressed
+  //by 32 bit indices, the root is node 0 once it is evaluated
+  s::vector<Node> mNodes;
+  s::vector<Edge> mEdges;
+  s::vector<Node> mSpareNodes;
+  s::vector<Edge> mSpareEdges;
+  GameState       mRootState;
+  uint            mRoot = NIL;
+
+  Edge& edge(uint node, uint i){
+    return mEdges[mNodes[node].first_edge + i];
+  }
+
+  //keeps the evaluation of gs in the cache and creates its node
+  uint add_evaluated(const GameState& gs, float qvalue, const float* priors, uint parent, uint edge_idx){
+    if (mCache != nullptr)
+      mCache->insert(gs.key(), qvalue, priors);
+    return add_node(gs, qvalue, priors, parent, edge_idx);
+  }
+  uint add_node(const GameState& gs, float qvalue, const float* priors, uint parent, uint edge_idx){
+    static_assert(GameState::IZ + 1 == BF, "mask bit index is the action index, pass is the last bit");
+
+    uint ret = mNodes.size();
+    mNodes.emplace_back(qvalue, parent, mEdges.size(), edge_idx);
+    if (not gs.is_over()){
+      //TODO: cannot switch to relaxed_legal_moves_mask, due to violating 0 liberty rule
+      typename GameState::MoveMask moves = gs.legal_moves_mask();
+      for_each_set_bit(moves, [&](uint midx){ mEdges.emplace_back(midx, priors[midx]); });
+      mNodes[ret].num_edges = mEdges.size() - mNodes[ret].first_edge;
     }
-    Node* child(uint midx){
-      return branches[midx].child;
+    if (parent != NIL)
+      edge(parent, edge_idx).child = ret;
+    return ret;
+  }
+
+  //a leaf waiting for evaluation, the edge of node has no child yet. the
+  //leaf of a root has no node
+  struct Leaf {
+    uint      node;
+    uint      edge;
+    GameState gs;
+
+    Leaf(uint node, uint edge, GameState&& gs): node(node), edge(edge), gs(s::move(gs)) {}
+  };
+
+  //a search between its rounds. the leaves of the round not found in the
+  //cache wait in misses for evaluation, the new nodes of the round wait in
+  //new_nodes for backup. a search whose root is not evaluated yet has no
+  //root and its only leaf is the root position
+  struct SearchTask {
+    uint              root;
+    SearchClock       clock;
+    s::vector<Leaf>   leaves;
+    s::vector<Leaf*>  misses;
+    s::vector<uint>   new_nodes;
+    s::vector<udyte>  path; //moves from the root of the last descent
+    bool              searching;
+    bool              in_round;
+    bool              checkpoint; //an iteration of the current round read the clock
+
+    SearchTask(uint root, const SearchBudget& budget):
+      root(root), clock(budget), searching(true), in_round(false), checkpoint(false) {}
+  };
+
+  //search of select_move, kept between the steps of the caller
+  s::optional<SearchTask> mTask;
+
+  //a root that is not kept from the last search is evaluated first
+  void start_task(SearchTask& task){
+    if (task.root != NIL) return;
+    task.leaves.emplace_back(NIL, 0U, GameState(mRootState));
+    find_cached(task);
+  }
+
+  //creates the nodes of the leaves found in the cache, the others are misses
+  void find_cached(SearchTask& task){
+    float value;
+    s::array<float, BF> cached;
+    task.misses.clear();
+    for (Leaf& leaf : task.leaves){
+      if (mCache != nullptr && mCache->find(leaf.gs.key(), value, cached.data()))
+        task.new_nodes.push_back(add_node(leaf.gs, value, cached.data(), leaf.node, leaf.edge));
+      else
+        task.misses.push_back(&leaf);
     }
-    float expected_value(uint midx){
-      return (branches[midx].visit_count > 0) ?
-        branches[midx].total_value / (float)branches[midx].visit_count :
-        0.F;
+  }
+
+  //creates the nodes of the misses, row i of values and priors is the
+  //evaluation of miss i
+  void add_evaluations(SearchTask& task, const float* values, const float* priors){
+    for (size_t i = 0; i < task.misses.size(); ++i){
+      const Leaf& leaf = *task.misses[i];
+      task.new_nodes.push_back(add_evaluated(leaf.gs, values[i], priors + i * BF, leaf.node, leaf.edge));
     }
-    float prior(uint midx){
-      return branches[midx].prior;
+    task.misses.clear();
+  }
+
+  void encode_misses(SearchTask& task, s::vector<t::Tensor>& boards, s::vector<t::Tensor>& states){
+    for (const Leaf* leaf : task.misses){
+      TensorP state = mEncoder.encode_state(leaf->gs, mDevice);
+      boards.push_back(state.x);
+      states.push_back(state.y);
     }
-    uint visit_count(uint midx){
-      return branches[midx].visit_count;
+  }
+
+  //encodes the misses into one batch and evaluates them with one forward
+  //pass, or sends them all to the inference server and waits for their
+  //results
+  void evaluate(SearchTask& task){
+    if (mServer != nullptr){
+      s::vector<s::future<Evaluation<BF>>> results;
+      results.reserve(task.misses.size());
+      for (const Leaf* leaf : task.misses)
+        results.push_back(mServer->evaluate(mEncoder.encode_state(leaf->gs, mDevice)));
+      for (size_t i = 0; i < task.misses.size(); ++i){
+        Evaluation<BF> eval = results[i].get();
+        const Leaf& leaf = *task.misses[i];
+        task.new_nodes.push_back(add_evaluated(leaf.gs, eval.value, eval.priors.data(), leaf.node, leaf.edge));
+      }
+      task.misses.clear();
+      return;
     }
-    void record_visit(uint midx, float value){
-      total_count += 1;
-      branches[midx].visit_count += 1;
-      branches[midx].total_value += value;
+
+    s::vector<t::Tensor> boards, states;
+    boards.reserve(task.misses.size());
+    states.reserve(task.misses.size());
+    encode_misses(task, boards, states);
+    long size = task.misses.size();
+    TensorP avout = mModel.model->forward(TensorP(t::stack(boards), t::stack(states)));
+    t::Tensor priors = avout.x.reshape({size, (long)BF}).to(t::Device(t::kCPU)).contiguous();
+    t::Tensor values = avout.y.reshape({size}).to(t::Device(t::kCPU)).contiguous();
+    add_evaluations(task, (float*)values.data_ptr(), (float*)priors.data_ptr());
+  }
+
+  //counts a pending simulation through edge of node and every edge above it
+  //as a loss, so the next descents of the batch spread out. count -1 takes
+  //it back
+  void virtual_loss(uint node, uint edge_idx, int count){
+    for (; node != NIL; edge_idx = mNodes[node].parent_edge, node = mNodes[node].parent){
+      Edge& e = edge(node, edge_idx);
+      mNodes[node].total_count += count;
+      e.visit_count += count;
+      e.total_value += count * MIN_SCORE;
     }
-  };
+  }
 
-  template <typename T>
-  struct BufferAllocator {
-    size_t index;
-    s::vector<T> objects;
+  //adds the value seen below edge of node to every edge up to the root,
+  //value is from the view of the player choosing at node
+  void backup(uint node, uint edge_idx, float value){
+    for (; node != NIL; edge_idx = mNodes[node].parent_edge, node = mNodes[node].parent){
+      Edge& e = edge(node, edge_idx);
+      mNodes[node].total_count += 1;
+      e.visit_count += 1;
+      e.total_value += value;
+      value = -1.F * value;
+    }
+  }
 
-    explicit BufferAllocator(size_t sz): index(0U), objects(sz){}
+  size_t subtree_size(uint node){
+    size_t ret = 1;
+    for (uint i = 0; i < mNodes[node].num_edges; ++i)
+      if (edge(node, i).child != NIL)
+        ret += subtree_size(edge(node, i).child);
+    return ret;
+  }
 
-    T* allocate(T&& obj) noexcept {
-      assert(index < objects.size());
+  //copies the subtree into the spare arenas, nodes left behind in the old
+  //arenas go away when they are cleared
+  uint move_subtree(uint node, uint parent, uint parent_edge){
+    uint ret = mSpareNodes.size();
+    uint first = mSpareEdges.size();
+    uint num_edges = mNodes[node].num_edges;
+    mSpareNodes.push_back(mNodes[node]);
+    mSpareNodes[ret].parent = parent;
+    mSpareNodes[ret].parent_edge = parent_edge;
+    mSpareNodes[ret].first_edge = first;
+    mSpareEdges.insert(s::end(mSpareEdges), s::begin(mEdges) + mNodes[node].first_edge, s::begin(mEdges) + mNodes[node].first_edge + num_edges);
+    for (uint i = 0; i < num_edges; ++i)
+      if (mSpareEdges[first + i].child != NIL)
+        mSpareEdges[first + i].child = move_subtree(mSpareEdges[first + i].child, ret, i);
+    return ret;
+  }
 
-      objects[index] = s::move(obj);
-      size_t prev_index = index;
-      index++;
-      return &objects[prev_index];
+  //node of the kept tree showing gs, it is the root or a node up to two
+  //moves below it, NIL if gs was not reached through the kept tree. the
+  //last move of gs is the move into the node, so only states along it are
+  //replayed
+  uint find_kept_node(const GameState& gs){
+    if (mRoot == NIL) return NIL;
+    if (is_same_position(mRootState, gs)) return mRoot;
+    Move last = gs.previous_move();
+    for (uint i = 0; i < mNodes[mRoot].num_edges; ++i){
+      const Edge& e = edge(mRoot, i);
+      if (e.child == NIL) continue;
+      Move move = mModel.action_encoder.idx_to_move(e.midx);
+      if (move == last){
+        GameState child_gs = mRootState;
+        child_gs.apply_move(move);
+        if (is_same_position(child_gs, gs)) return e.child;
+      }
+      for (uint j = 0; j < mNodes[e.child].num_edges; ++j){
+        const Edge& g = edge(e.child, j);
+        if (g.child == NIL || not (mModel.action_encoder.idx_to_move(g.midx) == last)) continue;
+        GameState grandchild_gs = mRootState;
+        grandchild_gs.apply_move(move);
+        grandchild_gs.apply_move(last);
+        if (is_same_position(grandchild_gs, gs)) return g.child;
+      }
     }
-  };
+    return NIL;
+  }
 
-  Node* create_node(BufferAllocator<Node>& arena, GameState&& gs, Node* parent = nullptr, uint midx = BF){
-    TensorP state = mModel.state_encoder.encode_state(gs, mDevice);
-    TensorP avout = mModel.model->forward(state);
-    t::Tensor priors = avout.x.to(t::Device(t::kCPU));
-    Node* new_node = arena.allocate(Node(s::move(gs), avout.y.item().to<float>(), (float*)priors.data_ptr(), parent, midx));
-    if (parent != nullptr){
-      assert(midx != BF);
-      parent->add_child(midx, new_node);
-    }
-    return new_node;
+  //makes gs the root state with room for the node budget, the matching
+  //subtree of the kept tree becomes the root with its statistics. the root
+  //is NIL if there is no such subtree
+  void reuse_root(const GameState& gs){
+    uint kept = find_kept_node(gs);
+    size_t kept_size = kept != NIL ? subtree_size(kept) : 0U;
+    mSpareNodes.clear();
+    mSpareEdges.clear();
+    mSpareNodes.reserve(kept_size + mBudget.nodes + 1);
+    mRoot = kept != NIL ? move_subtree(kept, NIL, 0U) : NIL;
+    s::swap(mNodes, mSpareNodes);
+    s::swap(mEdges, mSpareEdges);
+    mSpareNodes.clear();
+    mSpareEdges.clear();
+    mRootState = gs;
   }
 
-  uint select_branch(Node* node){
-    assert(node != nullptr);
-    if (node->gs.is_over()) return BF;
+  //edge of node to descend through, NIL at a terminal state
+  uint select_edge(uint node){
+    const Node& n = mNodes[node];
+    if (n.num_edges == 0) return NIL;
 
-    s::vector<Move> moves = node->gs.legal_moves(); //TODO: cannot switch to relaxed_legal_moves, due to violating 0 liberty rule
     s::array<float, BF> noise = mNoise(mGen);
-    float tcount = node->total_count;
+    float tcount = n.total_count;
     s::array<float, BF> score;
-    s::fill(s::begin(score), s::end(score), MIN_SCORE);
-    for (uint i = 0; i < moves.size(); ++i){
-      uint idx = mModel.action_encoder.move_to_idx(moves[i]);
-      float q = node->expected_value(idx);
-      float p = node->prior(idx);
-      float n = node->visit_count(idx);
-      score[idx] = q + mEFactor * ((1 - mNoiseFactor) * p + mNoiseFactor * noise[idx]) * (s::sqrt(tcount) / (n + 1));
+    for (uint i = 0; i < n.num_edges; ++i){
+      const Edge& e = mEdges[n.first_edge + i];
+      float q = e.expected_value();
+      float p = e.prior;
+      float c = e.visit_count;
+      score[i] = q + mEFactor * ((1 - mNoiseFactor) * p + mNoiseFactor * noise[e.midx]) * (s::sqrt(tcount) / (c + 1));
+    }
+
+    return random_max_element(s::begin(score), s::begin(score) + n.num_edges, [](float a, float b){return a < b;}) - s::begin(score);
+  }
+
+  //the most visited root edge cannot be caught up with the iterations left
+  bool is_decided(uint root, const SearchClock& clock){
+    uint first = 0, second = 0;
+    for (uint i = 0; i < mNodes[root].num_edges; ++i){
+      uint count = edge(root, i).visit_count;
+      if (count > first){
+        second = first;
+        first = count;
+      } else
+        second = s::max(second, count);
     }
+    return clock.decided(first, second);
+  }
 
-    uint max_idx = random_max_element(s::begin(score), s::end(score), [](float a, float b){return a < b;}) - s::begin(score);
-    return max_idx;
+  //descends up to mBatchSize paths from the root under virtual loss and
+  //lists their leaves, a descent reaching a leaf already listed ends the
+  //round early without counting as an iteration. false once the budget
+  //runs out or pondering is stopped
+  bool collect_leaves(SearchTask& task){
+    task.leaves.clear();
+    while (task.leaves.size() < mBatchSize){
+      if (mStopPonder.load(s::memory_order_relaxed))
+        return false;
+      uint node = task.root;
+      uint next_edge = select_edge(node);
+      task.path.clear();
+      while (next_edge != NIL && edge(node, next_edge).child != NIL){
+        task.path.push_back(edge(node, next_edge).midx);
+        node = edge(node, next_edge).child;
+        next_edge = select_edge(node); //terminal state has no next_edge
+      }
+      if (next_edge != NIL && s::any_of(s::begin(task.leaves), s::end(task.leaves), [&](const Leaf& leaf){ return leaf.node == node && leaf.edge == next_edge; }))
+        break;
+      if (not task.clock.next())
+        return false;
+      task.checkpoint |= task.clock.checkpoint();
+      if (next_edge == NIL){
+        //we reached terminal state, update visit count, we cannot choose
+        //to explore other nodes because visit count indicate best choice
+        backup(mNodes[node].parent, mNodes[node].parent_edge, -1.F * mNodes[node].qvalue);
+        continue;
+      }
+      //we have not expanded this node, its state is replayed from the root
+      GameState new_gs = mRootState;
+      for (udyte midx : task.path)
+        new_gs.apply_move(mModel.action_encoder.idx_to_move(midx));
+      new_gs.apply_move(mModel.action_encoder.idx_to_move(edge(node, next_edge).midx));
+      virtual_loss(node, next_edge, 1);
+      task.leaves.emplace_back(node, next_edge, s::move(new_gs));
+    }
+    return true;
   }
 
-  void append_experience(Node& root){
+  //runs the search until the leaves of a round wait for evaluation, true
+  //then and false once the search is over. each round descends up to
+  //mBatchSize paths, evaluates their leaves together and then backs up the
+  //values
+  bool advance(SearchTask& task){
+    if (task.root == NIL){
+      if (task.misses.size() > 0) return true;
+      task.root = mRoot = task.new_nodes.front();
+      task.new_nodes.clear();
+    }
+    while (true){
+      if (task.in_round){
+        // backup the tree to update visit counts
+        for (uint new_node : task.new_nodes){
+          const Node& n = mNodes[new_node];
+          virtual_loss(n.parent, n.parent_edge, -1);
+          backup(n.parent, n.parent_edge, -1.F * n.qvalue);
+        }
+        task.new_nodes.clear();
+        task.in_round = false;
+        if (task.checkpoint){
+          task.checkpoint = false;
+          if (is_decided(task.root, task.clock)) return false;
+        }
+      }
+      if (not task.searching) return false;
+      task.searching = collect_leaves(task);
+      task.in_round = true;
+      find_cached(task);
+      if (task.misses.size() > 0) return true;
+    }
+  }
+
+  //search from the root until the budget runs out or pondering is stopped
+  void grow_tree(const SearchBudget& budget){
+    SearchTask task(mRoot, budget);
+    start_task(task);
+    while (advance(task))
+      evaluate(task);
+  }
+
+  void append_experience(uint root){
     if (mExp){
-      TensorP state = mModel.state_encoder.encode_state(root.gs, mDevice);
+      TensorP state = mEncoder.encode_state(mRootState, mDevice);
       s::vector<float> visit_counts(BF);
-      for (uint i = 0; i < BF; ++i)
-        visit_counts[i] = root.branches[i].visit_count;
+      for (uint i = 0; i < mNodes[root].num_edges; ++i)
+        visit_counts[edge(root, i).midx] = edge(root, i).visit_count;
       mExp->append(state, visit_counts);
     }
   }
@@ -187,59 +471,128 @@ protected:
 public:
   ZeroAgent(Model& model, t::Device device, uint max_expansion, float exploration_factor, float noise_alpha, float noise_factor, uint seed):
     mModel(model),
+    mEncoder(model.state_encoder),
     mNoise(noise_alpha),
     mDevice(device),
     mGen(seed),
     mExp(nullptr),
-    mMaxExpand(max_expansion),
+    mBudget(max_expansion),
     mEFactor(exploration_factor),
-    mNoiseFactor(noise_factor)
+    mNoiseFactor(noise_factor),
+    mBatchSize(1U),
+    mCache(nullptr),
+    mServer(nullptr),
+    mStopPonder(false)
   {}
+  ~ZeroAgent(){
+    stop_pondering();
+  }
 
   Move select_move(const GameState& gs){
+    begin_search(gs);
+    while (step())
+      evaluate(*mTask);
+    return end_search();
+  }
+
+  //select_move split at the points where the search waits for evaluations,
+  //so one thread can drive the searches of many agents and evaluate their
+  //leaves together. begin_search starts a search of gs, step runs it until
+  //it waits and returns false once it is over, then end_search picks the
+  //move. while step returns true the caller encodes the waiting positions
+  //with encode_pending, evaluates them and hands the results back in the
+  //same order with resume
+  void begin_search(const GameState& gs){
     //root should never be a terminal state
     assert(not gs.is_over());
+    assert(not mTask);
+
+    stop_pondering();
+
+    //the subtree of gs from the last search keeps its visit counts
+    reuse_root(gs);
+    mTask.emplace(mRoot, mBudget);
+    start_task(*mTask);
+  }
+  bool step(){
+    assert(mTask);
+
+    return advance(*mTask);
+  }
+  size_t num_pending() const {
+    return mTask ? mTask->misses.size() : 0U;
+  }
+  void encode_pending(s::vector<t::Tensor>& boards, s::vector<t::Tensor>& states){
+    assert(mTask);
+
+    encode_misses(*mTask, boards, states);
+  }
+  //values holds num_pending values and priors num_pending rows of BF priors
+  void resume(const float* values, const float* priors){
+    assert(mTask);
+
+    add_evaluations(*mTask, values, priors);
+  }
+  Move end_search(){
+    assert(mTask);
+
+    uint root = mTask->root;
+    mTask.reset();
 
-    BufferAllocator<Node> arena(mMaxExpand + 1);
-    GameState gs_copy = gs;
-    Node* root = create_node(arena, s::move(gs_copy));
-    for (uint r = 0; r < mMaxExpand; ++r){
-      Node* node = root;
-      uint next_midx = select_branch(node);
-      while (node->has_child(next_midx)){
-        node = node->child(next_midx);   //node can be nullptr
-        next_midx = select_branch(node); //terminal state has no next_midx
-      }
-      float value;
-      if (next_midx >= BF){
-        //we reached terminal state, update visit count, we cannot choose
-        //to explore other nodes because visit count indicate best choice
-        value = -1.F * node->qvalue;
-        next_midx = node->last_midx;
-        node = node->parent;
-      } else {
-        //we have not expanded this node
-        GameState new_gs = node->gs;
-        Move move = mModel.action_encoder.idx_to_move(next_midx);
-        new_gs.apply_move(move);
-        Node* new_node = create_node(arena, s::move(new_gs), node, next_midx);
-        value = -1.F * new_node->qvalue;
-      }
-      // backup the tree to update visit counts
-      while (node != nullptr){
-        node->record_visit(next_midx, value);
-        next_midx = node->last_midx;
-        node = node->parent;
-        value = -1.F * value;
-      }
-    }
     //collects experience, for AlphaZero, it's the visit count
     //to select a move, pick the immediate branch with the highest visit
     //count
-    append_experience(*root);
+    append_experience(root);
+
+    Edge* edges = &mEdges[mNodes[root].first_edge];
+    Edge* best = random_max_element(edges, edges + mNodes[root].num_edges, [](const Edge& a, const Edge& b){ return a.visit_count < b.visit_count; });
+    return mModel.action_encoder.idx_to_move(best->midx);
+  }
+
+  //keep searching from gs, the position after the agent's own move, on a
+  //background thread until the next select_move, which finds the opponent's
+  //move among the children of the pondered tree. at most one node budget is
+  //spent pondering. the agent must not be used while pondering except for
+  //select_move and stop_pondering
+  void start_pondering(const GameState& gs){
+    stop_pondering();
+    if (gs.is_over()) return;
+
+    reuse_root(gs);
+    mPonder = s::thread(&ZeroAgent::grow_tree, this, SearchBudget(mBudget.nodes));
+  }
+  void stop_pondering(){
+    if (not mPonder.joinable()) return;
+    mStopPonder.store(true, s::memory_order_relaxed);
+    mPonder.join();
+    mStopPonder.store(false, s::memory_order_relaxed);
+  }
+
+  //evaluate up to batch_size leaves with one forward pass, descents of a
+  //batch are spread out by virtual loss. 1 evaluates every leaf on its own
+  void set_batch_size(uint batch_size){
+    assert(batch_size > 0);
+
+    mBatchSize = batch_size;
+  }
+
+  //look up evaluations in cache before running the model and store new
+  //ones there, one cache can be shared by agents playing with the same model
+  void set_cache(EvalCache<BF>& cache){
+    mCache = &cache;
+  }
+
+  //evaluate positions on the inference server instead of running the model
+  //on the calling thread, so agents of many concurrent games share batches
+  void set_server(InferenceServer<Model, BF>& server){
+    mServer = &server;
+  }
+
+  //limit later searches by time and node count instead of max_expansion
+  void set_budget(const SearchBudget& budget){
+    assert(budget.nodes > 0);
 
-    int max_midx = random_max_element(s::begin(root->branches), s::end(root->branches), [](Branch& a, Branch& b){ return a.visit_count < b.visit_count; }) - s::begin(root->branches);
-    return mModel.action_encoder.idx_to_move(max_midx);
+    mBudget = budget;
   }
 
   void set_exp(ZeroEpisodicExpCollector& exp){
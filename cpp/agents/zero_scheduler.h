@@ -0,0 +1,121 @@
+#ifndef RLGAMES_ZERO_SCHEDULER
+#define RLGAMES_ZERO_SCHEDULER
+
+#include <cassert>
+#include <vector>
+
+#include <type_alias.h>
+#include <types.h>
+#include <pytorch_util.h>
+
+#include <torch/torch.h>
+
+namespace rlgames {
+
+namespace s = std;
+namespace t = torch;
+
+//one game between two zero agents played as a task, the search of the
+//agent to move is suspended whenever it waits for evaluations
+template <typename Agent, typename GameState>
+class ZeroGameTask {
+  Agent*    mBlack;
+  Agent*    mWhite;
+  GameState mState;
+  uint      mSteps;
+  bool      mSearching;
+public:
+  ZeroGameTask(Agent& black, Agent& white):
+    mBlack(&black), mWhite(&white), mSteps(0), mSearching(false) {}
+
+  const GameState& state() const { return mState; }
+  uint steps() const { return mSteps; }
+  Player winner(){ return mState.winner(); }
+
+  //the agent to move, whose leaves wait while step returns true
+  Agent& agent(){
+    switch (mState.next_player()){
+    case Player::Black: return *mBlack;
+    case Player::White: return *mWhite;
+    default: assert(false);
+    }
+  }
+
+  //plays until the search of the agent to move waits for evaluations, true
+  //then and false once the game is over
+  bool step(){
+    while (not mState.is_over()){
+      Agent& player = agent();
+      if (not mSearching){
+        player.begin_search(mState);
+        mSearching = true;
+      }
+      if (player.step()) return true;
+      mState.apply_move(player.end_search());
+      mSearching = false;
+      mSteps++;
+    }
+    return false;
+  }
+};
+
+// runs many tasks on the calling thread with no locking. every round steps
+// each task that is not finished until it waits, evaluates the waiting
+// leaves of all tasks with one forward pass of the model and resumes them.
+// a task has bool step(), which returns false once the task is finished,
+// and agent(), the agent whose leaves wait
+template <typename Model, uint BF>
+class ZeroScheduler {
+  Model&               mModel;
+  s::vector<t::Tensor> mBoards;
+  s::vector<t::Tensor> mStates;
+  uint64               mBatches;
+  uint64               mPositions;
+public:
+  explicit ZeroScheduler(Model& model): mModel(model), mBatches(0), mPositions(0) {}
+
+  float mean_batch_size() const {
+    return mBatches == 0 ? 0.F : (float)mPositions / (float)mBatches;
+  }
+
+  //returns once every task is finished
+  template <typename Task>
+  void run(s::vector<Task>& tasks){
+    s::vector<Task*> live, waiting;
+    for (Task& task : tasks)
+      live.push_back(&task);
+    t::NoGradGuard no_grad;
+    while (live.size() > 0){
+      waiting.clear();
+      for (Task* task : live)
+        if (task->step())
+          waiting.push_back(task);
+      if (waiting.size() == 0) break;
+
+      mBoards.clear();
+      mStates.clear();
+      for (Task* task : waiting)
+        task->agent().encode_pending(mBoards, mStates);
+      long size = mBoards.size();
+      TensorP avout = mModel.model->forward(TensorP(t::stack(mBoards), t::stack(mStates)));
+      t::Tensor priors = avout.x.reshape({size, (long)BF}).to(t::Device(t::kCPU)).contiguous();
+      t::Tensor values = avout.y.reshape({size}).to(t::Device(t::kCPU)).contiguous();
+      float* prior_ptr = (float*)priors.data_ptr();
+      float* value_ptr = (float*)values.data_ptr();
+      size_t offset = 0;
+      for (Task* task : waiting){
+        size_t pending = task->agent().num_pending();
+        task->agent().resume(value_ptr + offset, prior_ptr + offset * BF);
+        offset += pending;
+      }
+      assert(offset == (size_t)size);
+      mBatches++;
+      mPositions += size;
+      live.swap(waiting);
+    }
+  }
+};
+
+} // rlgames
+
+#endif//RLGAMES_ZERO_SCHEDULER
@@ -2,7 +2,12 @@
 #define RLGAMES_BAG
 
 #include <cassert>
+#include <cstring>
+#include <new>
 #include <vector>
+#include <type_traits>
+
+#include <type_alias.h>
 
 namespace s = std;
 
@@ -36,6 +41,7 @@ public:
   //capacity
   size_t size() const { return mVec.size(); }
   void reserve(size_t sz){ mVec.reserve(sz); }
+  void resize(size_t sz){ mVec.resize(sz); }
   bool empty() const { return mVec.empty(); }
   
   //element access
@@ -105,6 +111,115 @@ typename s::vector<E>::iterator end(bag<E>& b){
   return b.end();
 }
 
+// bag with inline storage of at most N elements, no heap allocation. slots
+// past size() are left uninitialized and a copy moves only the elements in
+// use with one memcpy, so E must be trivially copyable
+template <typename E, size_t N>
+class fixed_bag {
+  static_assert(s::is_trivially_copyable<E>::value, "fixed_bag elements are copied with memcpy");
+
+  alignas(E) ubyte mBuf[sizeof(E) * N];
+  size_t           mSize;
+
+  using ref = E&;
+  using cref = const E&;
+  using iter = E*;
+  using citer = const E*;
+
+  E* data(){ return reinterpret_cast<E*>(mBuf); }
+  const E* data() const { return reinterpret_cast<const E*>(mBuf); }
+
+public:
+  fixed_bag(): mSize(0) {}
+  fixed_bag(const fixed_bag& o): mSize(o.mSize) {
+    s::memcpy(mBuf, o.mBuf, sizeof(E) * mSize);
+  }
+  fixed_bag& operator=(const fixed_bag& o){
+    if (this == &o) return *this;
+    mSize = o.mSize;
+    s::memcpy(mBuf, o.mBuf, sizeof(E) * mSize);
+    return *this;
+  }
+
+  //capacity
+  size_t size() const { return mSize; }
+  static constexpr size_t capacity(){ return N; }
+  //growing exposes slots that are only valid once written
+  void resize(size_t sz){
+    assert(sz <= N);
+    mSize = sz;
+  }
+  bool empty() const { return mSize == 0; }
+
+  //element access
+  ref operator[](size_t i){
+    assert(i < mSize);
+    return data()[i];
+  }
+  cref operator[](size_t i) const {
+    assert(i < mSize);
+    return data()[i];
+  }
+  ref back(){ return data()[mSize - 1]; }
+  cref back() const { return data()[mSize - 1]; }
+  ref front(){ return data()[0]; }
+  cref front() const { return data()[0]; }
+
+  //iterator
+  iter begin(){ return data(); }
+  iter end(){ return data() + mSize; }
+  citer cbegin() const { return data(); }
+  citer cend() const { return data() + mSize; }
+
+  //modifiers
+  uint push_back(const E& v){
+    assert(mSize < N);
+
+    new (data() + mSize) E(v);
+    return mSize++;
+  }
+  void pop_back(){
+    assert(mSize > 0);
+    mSize--;
+  }
+  void clear() noexcept { mSize = 0; }
+
+  ref push(size_t idx, cref value){
+    assert(idx <= mSize && mSize < N);
+
+    if (idx != mSize)
+      new (data() + mSize) E(data()[idx]);
+    new (data() + idx) E(value);
+    mSize++;
+    return data()[idx];
+  }
+  void pop(size_t idx){
+    assert(idx < mSize);
+
+    if (mSize > 1)
+      data()[idx] = data()[mSize - 1];
+    mSize--;
+  }
+
+  template <class... Args>
+  uint emplace_back(Args&&... args){
+    assert(mSize < N);
+
+    new (data() + mSize) E(args...);
+    return mSize++;
+  }
+};
+
+template <typename E, size_t N>
+E* begin(fixed_bag<E, N>& b){
+  return b.begin();
+}
+
+template <typename E, size_t N>
+E* end(fixed_bag<E, N>& b){
+  return b.end();
+}
+
 } // rlgames
 
 #endif//RLGAMES_BAG
@@ -0,0 +1,269 @@
+#ifndef RLGAMES_BITPLANE
+#define RLGAMES_BITPLANE
+
+#include <cassert>
+#include <type_traits>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include <type_alias.h>
+
+namespace s = std;
+
+namespace rlgames {
+
+__extension__ typedef unsigned __int128 uint128;
+
+// bit set of W 64 bit words, bit i of the board is bit i % 64 of word i / 64.
+// shifts move bits across word boundaries, with AVX2 the 8 word (512 bit)
+// set is shifted as two 256 bit lanes
+template <uint W>
+struct BitWords {
+  static constexpr uint WORDS = W;
+  static constexpr uint BITS = W * 64;
+private:
+  alignas(32) uint64 mW[W];
+public:
+  constexpr BitWords(): mW() {}
+
+  constexpr bool test(uint i) const { return (mW[i / 64] >> (i % 64)) & 1ULL; }
+  constexpr void set(uint i){ mW[i / 64] |= 1ULL << (i % 64); }
+  constexpr void reset(uint i){ mW[i / 64] &= ~(1ULL << (i % 64)); }
+
+  bool none() const {
+    uint64 acc = 0;
+    for (uint i = 0; i < W; ++i) acc |= mW[i];
+    return acc == 0;
+  }
+  bool any() const { return not none(); }
+  uint count() const {
+    uint ret = 0;
+    for (uint i = 0; i < W; ++i) ret += __builtin_popcountll(mW[i]);
+    return ret;
+  }
+  //index of lowest set bit, set must not be empty
+  uint first() const {
+    for (uint i = 0; i < W; ++i)
+      if (mW[i]) return i * 64 + __builtin_ctzll(mW[i]);
+    assert(false);
+    return BITS;
+  }
+  template <typename Fn>
+  void for_each(Fn fn) const {
+    for (uint i = 0; i < W; ++i)
+      for (uint64 w = mW[i]; w; w &= w - 1)
+        fn(i * 64 + __builtin_ctzll(w));
+  }
+
+  BitWords& operator&=(const BitWords& o){ for (uint i = 0; i < W; ++i) mW[i] &= o.mW[i]; return *this; }
+  BitWords& operator|=(const BitWords& o){ for (uint i = 0; i < W; ++i) mW[i] |= o.mW[i]; return *this; }
+  BitWords& operator^=(const BitWords& o){ for (uint i = 0; i < W; ++i) mW[i] ^= o.mW[i]; return *this; }
+  //this & ~o
+  BitWords andnot(const BitWords& o) const {
+    BitWords ret;
+    for (uint i = 0; i < W; ++i) ret.mW[i] = mW[i] & ~o.mW[i];
+    return ret;
+  }
+  bool operator==(const BitWords& o) const {
+    uint64 acc = 0;
+    for (uint i = 0; i < W; ++i) acc |= mW[i] ^ o.mW[i];
+    return acc == 0;
+  }
+
+  //shift toward higher bit index, 0 < k < 64
+  BitWords shl(uint k) const {
+    assert(k > 0 && k < 64);
+    BitWords ret;
+#ifdef __AVX2__
+    if constexpr (W == 8){
+      const __m256i zero = _mm256_setzero_si256();
+      const __m128i cl = _mm_cvtsi32_si128(k);
+      const __m128i cr = _mm_cvtsi32_si128(64 - k);
+      __m256i lo = _mm256_load_si256((const __m256i*)mW);
+      __m256i hi = _mm256_load_si256((const __m256i*)(mW + 4));
+      //rotate words up by one, lane 0 receives the word below it
+      __m256i plo = _mm256_permute4x64_epi64(lo, _MM_SHUFFLE(2, 1, 0, 3));
+      __m256i phi = _mm256_permute4x64_epi64(hi, _MM_SHUFFLE(2, 1, 0, 3));
+      __m256i clo = _mm256_blend_epi32(plo, zero, 0x03);
+      __m256i chi = _mm256_blend_epi32(phi, plo, 0x03);
+      lo = _mm256_or_si256(_mm256_sll_epi64(lo, cl), _mm256_srl_epi64(clo, cr));
+      hi = _mm256_or_si256(_mm256_sll_epi64(hi, cl), _mm256_srl_epi64(chi, cr));
+      _mm256_store_si256((__m256i*)ret.mW, lo);
+      _mm256_store_si256((__m256i*)(ret.mW + 4), hi);
+      return ret;
+    }
+#endif
+    ret.mW[0] = mW[0] << k;
+    for (uint i = 1; i < W; ++i)
+      ret.mW[i] = (mW[i] << k) | (mW[i - 1] >> (64 - k));
+    return ret;
+  }
+  //shift toward lower bit index, 0 < k < 64
+  BitWords shr(uint k) const {
+    assert(k > 0 && k < 64);
+    BitWords ret;
+#ifdef __AVX2__
+    if constexpr (W == 8){
+      const __m256i zero = _mm256_setzero_si256();
+      const __m128i cr = _mm_cvtsi32_si128(k);
+      const __m128i cl = _mm_cvtsi32_si128(64 - k);
+      __m256i lo = _mm256_load_si256((const __m256i*)mW);
+      __m256i hi = _mm256_load_si256((const __m256i*)(mW + 4));
+      //rotate words down by one, lane 3 receives the word above it
+      __m256i plo = _mm256_permute4x64_epi64(lo, _MM_SHUFFLE(0, 3, 2, 1));
+      __m256i phi = _mm256_permute4x64_epi64(hi, _MM_SHUFFLE(0, 3, 2, 1));
+      __m256i clo = _mm256_blend_epi32(plo, phi, 0xC0);
+      __m256i chi = _mm256_blend_epi32(phi, zero, 0xC0);
+      lo = _mm256_or_si256(_mm256_srl_epi64(lo, cr), _mm256_sll_epi64(clo, cl));
+      hi = _mm256_or_si256(_mm256_srl_epi64(hi, cr), _mm256_sll_epi64(chi, cl));
+      _mm256_store_si256((__m256i*)ret.mW, lo);
+      _mm256_store_si256((__m256i*)(ret.mW + 4), hi);
+      return ret;
+    }
+#endif
+    for (uint i = 0; i + 1 < W; ++i)
+      ret.mW[i] = (mW[i] >> k) | (mW[i + 1] << (64 - k));
+    ret.mW[W - 1] = mW[W - 1] >> k;
+    return ret;
+  }
+};
+
+// 128 bit set held in a single integer, the compiler lowers shifts into a
+// pair of double word shifts
+struct BitU128 {
+  static constexpr uint WORDS = 2;
+  static constexpr uint BITS = 128;
+private:
+  uint128 mV;
+public:
+  constexpr BitU128(): mV(0) {}
+
+  constexpr bool test(uint i) const { return (mV >> i) & 1U; }
+  constexpr void set(uint i){ mV |= (uint128)1U << i; }
+  constexpr void reset(uint i){ mV &= ~((uint128)1U << i); }
+
+  bool none() const { return mV == 0; }
+  bool any() const { return mV != 0; }
+  uint count() const {
+    return __builtin_popcountll((uint64)mV) + __builtin_popcountll((uint64)(mV >> 64));
+  }
+  uint first() const {
+    assert(mV != 0);
+    uint64 lo = (uint64)mV;
+    if (lo) return __builtin_ctzll(lo);
+    else    return 64 + __builtin_ctzll((uint64)(mV >> 64));
+  }
+  template <typename Fn>
+  void for_each(Fn fn) const {
+    for (uint64 w = (uint64)mV; w; w &= w - 1)
+      fn(__builtin_ctzll(w));
+    for (uint64 w = (uint64)(mV >> 64); w; w &= w - 1)
+      fn(64 + __builtin_ctzll(w));
+  }
+
+  BitU128& operator&=(const BitU128& o){ mV &= o.mV; return *this; }
+  BitU128& operator|=(const BitU128& o){ mV |= o.mV; return *this; }
+  BitU128& operator^=(const BitU128& o){ mV ^= o.mV; return *this; }
+  BitU128 andnot(const BitU128& o) const { BitU128 ret; ret.mV = mV & ~o.mV; return ret; }
+  bool operator==(const BitU128& o) const { return mV == o.mV; }
+
+  BitU128 shl(uint k) const { BitU128 ret; ret.mV = mV << k; return ret; }
+  BitU128 shr(uint k) const { BitU128 ret; ret.mV = mV >> k; return ret; }
+};
+
+//storage for a board of IZ points: one integer up to 128 points (9x9, 11x11),
+//8 words when the AVX2 two lane path applies (17x17 to 22x22, 19x19)
+template <uint IZ>
+using BitStorage = s::conditional_t<(IZ <= 64), BitWords<1>,
+                   s::conditional_t<(IZ <= 128), BitU128,
+                   s::conditional_t<(IZ > 256 && IZ <= 512), BitWords<8>,
+                                    BitWords<(IZ + 63) / 64>>>>;
+
+// one bit per point of a SZ x SZ board in row major order
+template <ubyte SZ>
+struct BitPlane : BitStorage<SZ * SZ> {
+  static constexpr uint SIZE = SZ;
+  static constexpr uint IZ = SZ * SZ;
+  using Storage = BitStorage<IZ>;
+
+  static_assert(SZ < 64, "row shift must fit in a word shift");
+
+  constexpr BitPlane() = default;
+  constexpr BitPlane(const Storage& o): Storage(o) {}
+
+  BitPlane operator&(const BitPlane& o) const { BitPlane ret = *this; ret &= o; return ret; }
+  BitPlane operator|(const BitPlane& o) const { BitPlane ret = *this; ret |= o; return ret; }
+  BitPlane operator^(const BitPlane& o) const { BitPlane ret = *this; ret ^= o; return ret; }
+  BitPlane andnot(const BitPlane& o) const { return Storage::andnot(o); }
+  BitPlane shl(uint k) const { return Storage::shl(k); }
+  BitPlane shr(uint k) const { return Storage::shr(k); }
+  bool operator!=(const BitPlane& o) const { return not Storage::operator==(o); }
+};
+
+template <ubyte SZ>
+struct BitMasks {
+  static constexpr uint IZ = SZ * SZ;
+
+  static constexpr BitPlane<SZ> make_full(){
+    BitPlane<SZ> ret;
+    for (uint i = 0; i < IZ; ++i) ret.set(i);
+    return ret;
+  }
+  //all points except those on column c
+  static constexpr BitPlane<SZ> make_without_column(uint c){
+    BitPlane<SZ> ret;
+    for (uint i = 0; i < IZ; ++i)
+      if (i % SZ != c) ret.set(i);
+    return ret;
+  }
+
+  static constexpr BitPlane<SZ> FULL        = make_full();
+  static constexpr BitPlane<SZ> NOT_FIRST   = make_without_column(0);
+  static constexpr BitPlane<SZ> NOT_LAST    = make_without_column(SZ - 1);
+};
+
+//points with an orthogonal neighbour in b, points of b included
+template <ubyte SZ>
+[[gnu::always_inline]] inline BitPlane<SZ> touching(const BitPlane<SZ>& b){
+  BitPlane<SZ> ret = b.shr(SZ);
+  ret |= b.shl(SZ) & BitMasks<SZ>::FULL;
+  ret |= b.shl(1) & BitMasks<SZ>::NOT_FIRST;
+  ret |= b.shr(1) & BitMasks<SZ>::NOT_LAST;
+  return ret;
+}
+
+//points orthogonally adjacent to b, excluding b itself
+template <ubyte SZ>
+[[gnu::always_inline]] inline BitPlane<SZ> adjacent(const BitPlane<SZ>& b){
+  return touching(b).andnot(b);
+}
+
+//all points of region connected to seed, seed must be inside region
+template <ubyte SZ>
+BitPlane<SZ> flood_fill(const BitPlane<SZ>& seed, const BitPlane<SZ>& region){
+  BitPlane<SZ> ret = seed;
+  while (true){
+    BitPlane<SZ> grown = ret | (adjacent(ret) & region);
+    if (grown == ret) return ret;
+    ret = grown;
+  }
+}
+
+//grow string inside region like flood_fill, but stop as soon as it touches
+//one of liberties. returns true if the whole string has no such liberty
+template <ubyte SZ>
+bool flood_fill_without_liberty(BitPlane<SZ>& string, const BitPlane<SZ>& region, const BitPlane<SZ>& liberties){
+  while (true){
+    BitPlane<SZ> adj = adjacent(string);
+    if ((adj & liberties).any()) return false;
+    BitPlane<SZ> grown = string | (adj & region);
+    if (grown == string) return true;
+    string = grown;
+  }
+}
+
+} //rlgames
+
+#endif//RLGAMES_BITPLANE
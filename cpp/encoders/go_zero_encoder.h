@@ -24,24 +24,26 @@ namespace t = torch;
 // Plane 8 are illegal moves due to ko
 // Additional 2 dim out-of-plane information on if player get komi (1 if yes) and if opponent gets komi,
 // maybe this is better with the actual komi value
+// Board is the board layout of the game state, any board whose get_string()
+// result has num_liberties()
 
-template <ubyte SZ>
-class ZeroGoStateEncoder : public StateEncoderBase<GoGameState<SZ>, TensorP, ZeroGoStateEncoder<SZ>> {
+template <ubyte SZ, typename Board = GoBoard<SZ>>
+class ZeroGoStateEncoder : public StateEncoderBase<GoGameState<SZ, Board>, TensorP, ZeroGoStateEncoder<SZ, Board>> {
   mutable float mBoard[SZ * SZ * 9];
   mutable float mState[2];
 
   static constexpr uint IZ = SZ * SZ;
 public:
   //TODO: encode_state takes 9% of total computational time
-  TensorP encode_state(const GoGameState<SZ>& gs, t::Device device){
-    const GoBoard<SZ>& board = gs.board();
+  TensorP encode_state(const GoGameState<SZ, Board>& gs, t::Device device){
+    const Board& board = gs.board();
     Player nplayer = gs.next_player();
     s::fill(mBoard, mBoard + SZ * SZ * 9, 0.f);
     for (uint i = 0; i < SZ; ++i)
       for (uint j = 0; j < SZ; ++j){
         Pt pt(i, j);
         uint idx = index<SZ>(pt);
-        const GoStr<SZ>* string = board.get_string(pt);
+        auto string = board.get_string(pt);
         Player player = board.get(pt);
         if (string){
           switch (string->num_liberties()){
@@ -0,0 +1,134 @@
+#ifndef RLGAMES_EVAL_CACHE
+#define RLGAMES_EVAL_CACHE
+
+#include <cassert>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+
+#include <type_alias.h>
+
+namespace s = std;
+
+namespace rlgames {
+
+// fixed size cache of network evaluations, the value and the BF move priors
+// of a position keyed by its zobrist key including the side to move. the key
+// picks a set of WAYS entries, a full set evicts by clock: the hand skips and
+// clears entries read since it last passed them and takes the first one that
+// was not. every set has its own lock so agents on different threads can
+// share one cache. entries are only good for the model that computed them,
+// clear the cache when the model changes
+template <uint BF>
+class EvalCache {
+  static constexpr uint WAYS = 4;
+
+  struct Entry {
+    uint64              key;
+    float               value;
+    bool                used;
+    bool                referenced;
+    s::array<float, BF> priors;
+
+    Entry(): key(0), value(0.F), used(false), referenced(false) {}
+  };
+
+  struct Set {
+    s::mutex              lock;
+    uint                  hand;
+    s::array<Entry, WAYS> entries;
+
+    Set(): hand(0) {}
+  };
+
+  s::unique_ptr<Set[]> mSets;
+  size_t               mMask;
+  s::atomic<uint64>    mHits;
+  s::atomic<uint64>    mMisses;
+
+  static size_t num_sets(size_t capacity){
+    size_t ret = 1;
+    while (ret * WAYS < capacity)
+      ret <<= 1;
+    return ret;
+  }
+  //zobrist keys are uniformly random, the high bits pick the set so the
+  //low bits are left to tell keys in one set apart
+  Set& set_of(uint64 key){
+    return mSets[(key >> 32) & mMask];
+  }
+public:
+  //capacity is rounded up to a power of two sets
+  explicit EvalCache(size_t capacity):
+    mSets(new Set[num_sets(capacity)]), mMask(num_sets(capacity) - 1), mHits(0), mMisses(0) {
+    assert(capacity > 0);
+  }
+
+  size_t capacity() const { return (mMask + 1) * WAYS; }
+  uint64 hits() const { return mHits.load(s::memory_order_relaxed); }
+  uint64 misses() const { return mMisses.load(s::memory_order_relaxed); }
+  float hit_rate() const {
+    uint64 total = hits() + misses();
+    return total == 0 ? 0.F : (float)hits() / (float)total;
+  }
+
+  //copies the evaluation of key into value and priors if it is cached
+  bool find(uint64 key, float& value, float* priors){
+    Set& set = set_of(key);
+    {
+      s::lock_guard<s::mutex> guard(set.lock);
+      for (Entry& entry : set.entries)
+        if (entry.used && entry.key == key){
+          entry.referenced = true;
+          value = entry.value;
+          s::copy(s::begin(entry.priors), s::end(entry.priors), priors);
+          mHits.fetch_add(1, s::memory_order_relaxed);
+          return true;
+        }
+    }
+    mMisses.fetch_add(1, s::memory_order_relaxed);
+    return false;
+  }
+
+  void insert(uint64 key, float value, const float* priors){
+    Set& set = set_of(key);
+    s::lock_guard<s::mutex> guard(set.lock);
+    Entry* victim = nullptr;
+    for (Entry& entry : set.entries){
+      //another thread evaluated the same position first
+      if (entry.used && entry.key == key) return;
+      if (not entry.used && victim == nullptr)
+        victim = &entry;
+    }
+    while (victim == nullptr){
+      Entry& entry = set.entries[set.hand];
+      set.hand = (set.hand + 1) % WAYS;
+      if (entry.referenced) entry.referenced = false;
+      else                  victim = &entry;
+    }
+    victim->key = key;
+    victim->value = value;
+    victim->used = true;
+    victim->referenced = false;
+    s::copy(priors, priors + BF, s::begin(victim->priors));
+  }
+
+  //drops every entry and the counters, not safe while the cache is in use
+  void clear(){
+    for (size_t i = 0; i <= mMask; ++i){
+      for (Entry& entry : mSets[i].entries){
+        entry.used = false;
+        entry.referenced = false;
+      }
+      mSets[i].hand = 0;
+    }
+    mHits.store(0, s::memory_order_relaxed);
+    mMisses.store(0, s::memory_order_relaxed);
+  }
+};
+
+} // rlgames
+
+#endif//RLGAMES_EVAL_CACHE
@@ -0,0 +1,216 @@
+#ifndef RLGAMES_GO_BITBOARD
+#define RLGAMES_GO_BITBOARD
+
+#include <cassert>
+#include <array>
+#include <optional>
+#include <ostream>
+
+#include <type_alias.h>
+#include <types.h>
+#include <zobrist_hash.h>
+#include <game_base.h>
+#include <bitplane.h>
+#include <go_types.h>
+
+namespace s = std;
+
+namespace rlgames {
+
+// string view computed on demand from the bitboard
+template <ubyte SZ>
+struct GoBitString {
+  static constexpr uint SIZE = SZ;
+  static constexpr uint IZ = SZ * SZ;
+private:
+  BitPlane<SZ> mStones;
+  BitPlane<SZ> mLiberties;
+  Player       mColor;
+public:
+  GoBitString(const BitPlane<SZ>& stones, const BitPlane<SZ>& liberties, Player color):
+    mStones(stones), mLiberties(liberties), mColor(color) {}
+
+  Player color() const { return mColor; }
+  const BitPlane<SZ>& stones() const { return mStones; }
+  const BitPlane<SZ>& liberties() const { return mLiberties; }
+  size_t size() const { return mStones.count(); }
+  size_t num_liberties() const { return mLiberties.count(); }
+};
+
+// Go board stored as one bit plane per color. strings are not stored, they
+// are recovered by flood fill over the stones of one color when needed, so
+// place_stone only touches the strings adjacent to the new stone and a copy
+// of the board is two bit planes and a hash
+template <ubyte SZ>
+struct GoBitBoard : Board<GoBitBoard<SZ>> {
+  static constexpr uint SIZE = SZ;
+  static constexpr uint IZ   = SZ * SZ;
+
+  struct Undo {
+    BitPlane<SZ> black;
+    BitPlane<SZ> white;
+    uint64       hash;
+
+    Undo(): hash(EMPTY_BOARD) {}
+  };
+private:
+  BitPlane<SZ> mBlack;
+  BitPlane<SZ> mWhite;
+  uint64       mHash;
+protected:
+  BitPlane<SZ>& stones_of(Player player){
+    assert(player == Player::Black || player == Player::White);
+
+    return player == Player::Black ? mBlack : mWhite;
+  }
+  static BitPlane<SZ> single(Pt pt){
+    BitPlane<SZ> ret;
+    ret.set(index<SZ>(pt));
+    return ret;
+  }
+  uint64 stones_hash(Player player, const BitPlane<SZ>& stones) const {
+    uint64 ret = EMPTY_BOARD;
+    stones.for_each([&](uint i){ ret ^= zobrist_hash<SZ>(player, point<SZ>(i)); });
+    return ret;
+  }
+  //union of opponent strings adjacent to pt that have no liberty other than pt
+  BitPlane<SZ> captured_by(Player player, Pt pt) const {
+    const BitPlane<SZ>& theirs = stones(other_player(player));
+    BitPlane<SZ> empties = empty().andnot(single(pt));
+    BitPlane<SZ> candidates = adjacent(single(pt)) & theirs;
+    BitPlane<SZ> ret;
+    while (candidates.any()){
+      BitPlane<SZ> string;
+      string.set(candidates.first());
+      if (flood_fill_without_liberty(string, theirs, empties))
+        ret |= string;
+      candidates = candidates.andnot(string);
+    }
+    return ret;
+  }
+public:
+  GoBitBoard(): mHash(EMPTY_BOARD) {}
+
+  uint size() const { return SZ; }
+  uint64 hash() const { return mHash; }
+  bool is_on_grid(Pt pt) const { return (pt.r < SZ && pt.c < SZ); }
+  Player get(Pt pt) const {
+    assert(is_on_grid(pt));
+
+    uint idx = index<SZ>(pt);
+    if      (mBlack.test(idx)) return Player::Black;
+    else if (mWhite.test(idx)) return Player::White;
+    else                       return Player::Unknown;
+  }
+  const BitPlane<SZ>& stones(Player player) const {
+    assert(player == Player::Black || player == Player::White);
+
+    return player == Player::Black ? mBlack : mWhite;
+  }
+  BitPlane<SZ> empty() const {
+    return BitMasks<SZ>::FULL.andnot(mBlack | mWhite);
+  }
+  //string containing pt, computed by flood fill, empty if there is no stone
+  s::optional<GoBitString<SZ>> get_string(Pt pt) const {
+    Player color = get(pt);
+    if (color == Player::Unknown) return s::nullopt;
+    BitPlane<SZ> string = flood_fill(single(pt), stones(color));
+    return GoBitString<SZ>(string, adjacent(string) & empty(), color);
+  }
+  bool is_self_capture(Player player, Pt pt) const {
+    assert(get(pt) == Player::Unknown);
+
+    BitPlane<SZ> stone = single(pt);
+    BitPlane<SZ> empties = empty().andnot(stone);
+    if ((adjacent(stone) & empties).any()) return false;
+    BitPlane<SZ> string = stone;
+    if (not flood_fill_without_liberty(string, stones(player) | stone, empties)) return false;
+    return captured_by(player, pt).none();
+  }
+  uint64 hash_after_move(Player player, Pt pt) const {
+    assert(get(pt) == Player::Unknown);
+
+    return mHash ^ zobrist_hash<SZ>(player, pt) ^ stones_hash(other_player(player), captured_by(player, pt));
+  }
+  void place_stone(Player player, Pt pt){
+    assert(is_on_grid(pt));
+    assert(get(pt) == Player::Unknown);
+
+    Player opponent = other_player(player);
+    BitPlane<SZ> captured = captured_by(player, pt);
+    stones_of(player).set(index<SZ>(pt));
+    mHash ^= zobrist_hash<SZ>(player, pt);
+    if (captured.any()){
+      stones_of(opponent) = stones_of(opponent).andnot(captured);
+      mHash ^= stones_hash(opponent, captured);
+    }
+    //not removing new string without liberty here, allow board to show self
+    //capture happened for rule checking
+  }
+  //the whole board is the before-image
+  void place_stone(Player player, Pt pt, Undo& undo){
+    undo.black = mBlack;
+    undo.white = mWhite;
+    undo.hash  = mHash;
+    place_stone(player, pt);
+  }
+  void undo(const Undo& undo){
+    mBlack = undo.black;
+    mWhite = undo.white;
+    mHash  = undo.hash;
+  }
+
+  s::ostream& print(s::ostream& out) const {
+    char bchar = 'X';
+    char wchar = '0';
+
+    out << "   ";
+    if (SZ > 9) out << " ";
+    for (char c = 'A', i = 0; i < SZ; c++, i++){
+      if (c == 'I') c++;
+      out << c << ' ';
+    }
+    out << '\n';
+    for (ubyte i = SZ - 1; i < SZ; --i){
+      if (i < 10) out << ' ';
+      out << i + 1 << ' ';
+      for (ubyte j = 0; j < SZ; ++j){
+        switch (get(Pt(i, j))){
+        case Player::Black: out << bchar; break;
+        case Player::White: out << wchar; break;
+        default:            out << '.';
+        }
+        out << ' ';
+      }
+      out << i + 1 << '\n';
+    }
+    out << "   ";
+    if (SZ > 9) out << " ";
+    for (char c = 'A', i = 0; i < SZ; c++, i++){
+      if (c == 'I') c++;
+      out << c << ' ';
+    }
+    out << '\n';
+    return out;
+  }
+};
+
+template <ubyte SZ>
+s::ostream& operator<<(s::ostream& out, const GoBitBoard<SZ>& board){
+  return board.print(out);
+}
+
+template <ubyte SZ>
+struct StonePlanes<SZ, GoBitBoard<SZ>> {
+  void operator()(const GoBitBoard<SZ>& board, BitPlane<SZ>& black, BitPlane<SZ>& white){
+    black = board.stones(Player::Black);
+    white = board.stones(Player::White);
+  }
+};
+
+template <ubyte SZ>
+using GoBitGameState = GoGameState<SZ, GoBitBoard<SZ>>;
+
+} //rlgames
+
+#endif//RLGAMES_GO_BITBOARD
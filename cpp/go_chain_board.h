@@ -0,0 +1,336 @@
+#ifndef RLGAMES_GO_CHAIN_BOARD
+#define RLGAMES_GO_CHAIN_BOARD
+
+#include <cassert>
+#include <cstring>
+#include <bitset>
+#include <array>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <ostream>
+
+#include <type_alias.h>
+#include <types.h>
+#include <zobrist_hash.h>
+#include <game_base.h>
+#include <go_types.h>
+
+namespace s = std;
+
+namespace rlgames {
+
+// string head record, only valid at the head stone of a string
+template <ubyte SZ>
+struct GoChain {
+  static constexpr uint SIZE = SZ;
+  static constexpr uint IZ = SZ * SZ;
+private:
+  s::bitset<IZ> mLiberties;
+  uint64        mHash;  //zobrist hash of all stones in the string
+  udyte         mSize;
+  Player        mColor;
+public:
+  GoChain(): mHash(EMPTY_BOARD), mSize(0), mColor(Player::Unknown) {}
+  GoChain(Player color, const s::bitset<IZ>& liberties, uint64 hash):
+    mLiberties(liberties), mHash(hash), mSize(1), mColor(color) {}
+  GoChain(const GoChain& o): mLiberties(o.mLiberties), mHash(o.mHash), mSize(o.mSize), mColor(o.mColor) {}
+  GoChain& operator=(const GoChain& o){
+    mLiberties = o.mLiberties;
+    mHash = o.mHash;
+    mSize = o.mSize;
+    mColor = o.mColor;
+    return *this;
+  }
+
+  Player color() const { return mColor; }
+  uint64 hash() const { return mHash; }
+  uint size() const { return mSize; }
+  const s::bitset<IZ>& liberties() const { return mLiberties; }
+  size_t num_liberties() const { return mLiberties.count(); }
+
+  void add_liberty(uint idx){ mLiberties.set(idx); }
+  void remove_liberty(uint idx){ mLiberties.reset(idx); }
+  //stones of two strings are never liberties of each other, no need to mask
+  void merge(const GoChain& b){
+    assert(mColor == b.mColor);
+
+    mSize      += b.mSize;
+    mLiberties |= b.mLiberties;
+    mHash      ^= b.mHash;
+  }
+};
+
+// Go board that keeps each string as a ring of stones linked through mNext,
+// every stone points at the head stone of its string through mHead, and the
+// string information lives in a GoChain record stored at the head index.
+// merging strings relabels only the smaller string and splices the two rings,
+// capturing a string visits only the captured stones
+template <ubyte SZ>
+struct GoChainBoard : Board<GoChainBoard<SZ>> {
+  static constexpr uint SIZE   = SZ;
+  static constexpr uint IZ     = SZ * SZ;
+  static constexpr udyte EMPTY = 0xFFFFU;
+
+  //before-image of everything place_stone modifies, string records are saved
+  //on first write only
+  struct Undo {
+    s::array<udyte, IZ>                    head;
+    s::array<udyte, IZ>                    next;
+    s::vector<s::pair<udyte, GoChain<SZ>>> chains;
+    s::bitset<IZ>                          saved;
+    uint64                                 hash;
+
+    Undo(): hash(EMPTY_BOARD) {}
+  };
+private:
+  s::array<GoChain<SZ>, IZ> mChains; //string records, indexed by head stone
+  s::array<udyte, IZ>       mHead;   //head stone of the string, EMPTY if no stone
+  s::array<udyte, IZ>       mNext;   //next stone in the string ring
+  uint64                    mHash;
+protected:
+  udyte get_head(Pt pt) const {
+    assert(is_on_grid(pt));
+
+    return mHead[index<SZ>(pt)];
+  }
+  void save_chain(Undo* undo, udyte head){
+    if (undo == nullptr || undo->saved.test(head)) return;
+    undo->saved.set(head);
+    undo->chains.emplace_back(head, mChains[head]);
+  }
+  void relabel(udyte from, udyte to){
+    udyte stone = from;
+    do {
+      mHead[stone] = to;
+      stone = mNext[stone];
+    } while (stone != from);
+  }
+  //joining two disjoint rings is a swap of their successors
+  void splice(udyte a, udyte b){
+    s::swap(mNext[a], mNext[b]);
+  }
+  void remove_chain(udyte head, Undo* undo = nullptr){
+    mHash ^= mChains[head].hash();
+    udyte stone = head;
+    do {
+      Pt pt = point<SZ>(stone);
+      for (Pt neighbour : neighbours(pt)){
+        if (not is_on_grid(neighbour)) continue;
+
+        udyte nhead = get_head(neighbour);
+        if (nhead != EMPTY && nhead != head){
+          save_chain(undo, nhead);
+          mChains[nhead].add_liberty(stone);
+        }
+      }
+      udyte next = mNext[stone];
+      mHead[stone] = EMPTY;
+      stone = next;
+    } while (stone != head);
+  }
+  void place_stone(Player player, Pt pt, Undo* undo){
+    assert(is_on_grid(pt));
+    assert(get_head(pt) == EMPTY);
+
+    uint64 stone_hash = zobrist_hash<SZ>(player, pt);
+    mHash ^= stone_hash;
+
+    udyte idx = index<SZ>(pt);
+    s::bitset<IZ> liberties;
+    s::array<udyte, 4> adj_same_color;
+    s::array<udyte, 4> adj_oppo_color;
+    decltype(s::begin(adj_same_color)) adj_same_iter = s::begin(adj_same_color);
+    decltype(s::begin(adj_oppo_color)) adj_oppo_iter = s::begin(adj_oppo_color);
+
+    for (Pt neighbour : neighbours(pt)){
+      if (not is_on_grid(neighbour)) continue;
+
+      udyte nhead = get_head(neighbour);
+      if (nhead == EMPTY)
+        liberties.set(index<SZ>(neighbour));
+      else if (mChains[nhead].color() == player){
+        if (s::find(s::begin(adj_same_color), adj_same_iter, nhead) == adj_same_iter)
+          *(adj_same_iter++) = nhead;
+      } else {
+        if (s::find(s::begin(adj_oppo_color), adj_oppo_iter, nhead) == adj_oppo_iter)
+          *(adj_oppo_iter++) = nhead;
+      }
+    }
+
+    mHead[idx] = idx;
+    mNext[idx] = idx;
+    save_chain(undo, idx);
+    mChains[idx] = GoChain<SZ>(player, liberties, stone_hash);
+
+    //merge all same color string together, smaller string joins the larger one
+    udyte head = idx;
+    for (decltype(s::begin(adj_same_color)) it = s::begin(adj_same_color); it != adj_same_iter; ++it){
+      udyte other = *it;
+      save_chain(undo, other);
+      mChains[other].remove_liberty(idx);
+      if (mChains[other].size() > mChains[head].size())
+        s::swap(other, head);
+      relabel(other, head);
+      splice(other, head);
+      mChains[head].merge(mChains[other]);
+    }
+
+    //remove opponent dead string
+    for (decltype(s::begin(adj_oppo_color)) it = s::begin(adj_oppo_color); it != adj_oppo_iter; ++it){
+      save_chain(undo, *it);
+      mChains[*it].remove_liberty(idx);
+      if (mChains[*it].num_liberties() == 0)
+        remove_chain(*it, undo);
+    }
+    //not removing new merged string here, allow board to show self capture
+    //happened for rule checking
+  }
+public:
+  GoChainBoard(): mHash(EMPTY_BOARD) {
+    s::memset(mHead.data(), 0xFFU, sizeof(udyte) * IZ);
+    s::memset(mNext.data(), 0xFFU, sizeof(udyte) * IZ);
+  }
+  GoChainBoard(const GoChainBoard& o): mChains(o.mChains), mHead(o.mHead), mNext(o.mNext), mHash(o.mHash) {}
+  GoChainBoard& operator=(const GoChainBoard& o){
+    mChains = o.mChains;
+    mHead   = o.mHead;
+    mNext   = o.mNext;
+    mHash   = o.mHash;
+    return *this;
+  }
+
+  uint size() const { return SZ; }
+  uint64 hash() const { return mHash; }
+  bool is_on_grid(Pt pt) const { return (pt.r < SZ && pt.c < SZ); }
+  Player get(Pt pt) const {
+    assert(is_on_grid(pt));
+
+    udyte head = get_head(pt);
+    if (head == EMPTY) return Player::Unknown;
+    else               return mChains[head].color();
+  }
+  const GoChain<SZ>* get_string(Pt pt) const {
+    assert(is_on_grid(pt));
+
+    udyte head = get_head(pt);
+    if (head == EMPTY) return nullptr;
+    else               return &mChains[head];
+  }
+  //whether placing a stone at empty pt leaves its string without liberty,
+  //decided from the neighbouring strings without a trial board
+  bool is_self_capture(Player player, Pt pt) const {
+    assert(get_head(pt) == EMPTY);
+
+    for (Pt neighbour : neighbours(pt)){
+      if (not is_on_grid(neighbour)) continue;
+
+      udyte nhead = get_head(neighbour);
+      if (nhead == EMPTY) return false;
+      size_t liberties = mChains[nhead].num_liberties();
+      if (mChains[nhead].color() == player){
+        if (liberties > 1) return false;
+      } else if (liberties == 1)
+        return false;
+    }
+    return true;
+  }
+  //board hash after placing a stone at empty pt, including captured stones
+  uint64 hash_after_move(Player player, Pt pt) const {
+    assert(get_head(pt) == EMPTY);
+
+    uint64 hash = mHash ^ zobrist_hash<SZ>(player, pt);
+    s::array<udyte, 4> captured;
+    decltype(s::begin(captured)) captured_iter = s::begin(captured);
+    for (Pt neighbour : neighbours(pt)){
+      if (not is_on_grid(neighbour)) continue;
+
+      udyte nhead = get_head(neighbour);
+      if (nhead == EMPTY || mChains[nhead].color() == player || mChains[nhead].num_liberties() != 1) continue;
+      if (s::find(s::begin(captured), captured_iter, nhead) != captured_iter) continue;
+      *(captured_iter++) = nhead;
+      hash ^= mChains[nhead].hash();
+    }
+    return hash;
+  }
+  void place_stone(Player player, Pt pt){
+    place_stone(player, pt, nullptr);
+  }
+  //place stone and record what is needed to take it back with undo()
+  void place_stone(Player player, Pt pt, Undo& undo){
+    undo.head = mHead;
+    undo.next = mNext;
+    undo.chains.clear();
+    undo.saved.reset();
+    undo.hash = mHash;
+    place_stone(player, pt, &undo);
+  }
+  void undo(const Undo& undo){
+    for (const s::pair<udyte, GoChain<SZ>>& saved : undo.chains)
+      mChains[saved.first] = saved.second;
+    mHead = undo.head;
+    mNext = undo.next;
+    mHash = undo.hash;
+  }
+
+  s::ostream& print(s::ostream& out) const {
+    char bchar = 'X';
+    char wchar = '0';
+
+    out << "   ";
+    if (SZ > 9) out << " ";
+    for (char c = 'A', i = 0; i < SZ; c++, i++){
+      if (c == 'I') c++;
+      out << c << ' ';
+    }
+    out << '\n';
+    for (ubyte i = SZ - 1; i < SZ; --i){
+      if (i < 10) out << ' ';
+      out << i + 1 << ' ';
+      for (ubyte j = 0; j < SZ; ++j){
+        switch (get(Pt(i, j))){
+        case Player::Black: out << bchar; break;
+        case Player::White: out << wchar; break;
+        default:            out << '.';
+        }
+        out << ' ';
+      }
+      out << i + 1 << '\n';
+    }
+    out << "   ";
+    if (SZ > 9) out << " ";
+    for (char c = 'A', i = 0; i < SZ; c++, i++){
+      if (c == 'I') c++;
+      out << c << ' ';
+    }
+    out << '\n';
+    return out;
+  }
+
+  s::ostream& debug(s::ostream& out) const {
+    for (ubyte i = 0; i < SZ; ++i){
+      for (ubyte j = 0; j < SZ; ++j){
+        udyte head = get_head(Pt(i, j));
+        if (head == EMPTY)
+          out << "  ";
+        else {
+          out << s::hex << head << " ";
+        }
+      }
+      out << "\n";
+    }
+    return out;
+  }
+};
+
+template <ubyte SZ>
+s::ostream& operator<<(s::ostream& out, const GoChainBoard<SZ>& board){
+  return board.print(out);
+}
+
+template <ubyte SZ>
+using GoChainGameState = GoGameState<SZ, GoChainBoard<SZ>>;
+
+} //rlgames
+
+#endif//RLGAMES_GO_CHAIN_BOARD
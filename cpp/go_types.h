@@ -6,7 +6,9 @@
 #include <bitset>
 #include <array>
 #include <vector>
-#include <unordered_set>
+#include <utility>
+#include <optional>
+#include <memory>
 #include <functional>
 #include <algorithm>
 #include <ostream>
@@ -16,11 +18,25 @@
 #include <bag.h>
 #include <zobrist_hash.h>
 #include <game_base.h>
+#include <bitplane.h>
 
 namespace s = std;
 
 namespace rlgames {
 
+//visit index of every set bit in ascending order
+template <size_t N, typename Fn>
+[[gnu::always_inline]] inline void for_each_set_bit(const s::bitset<N>& bits, Fn fn){
+#ifdef __GLIBCXX__
+  for (size_t i = bits._Find_first(); i < N; i = bits._Find_next(i))
+    fn(i);
+#else
+  for (size_t i = 0; i < N; ++i)
+    if (bits.test(i))
+      fn(i);
+#endif
+}
+
 template <ubyte SZ>
 struct GoStr {
   static constexpr uint SIZE = SZ;
@@ -28,38 +44,28 @@ struct GoStr {
 private:
   s::bitset<IZ> mStones;
   s::bitset<IZ> mLiberties;
+  uint64        mHash;  //zobrist hash of all stones in the string
   Player        mColor;
 public:
-  GoStr(): mColor(Player::Unknown){}
-  GoStr(const s::bitset<IZ>& stones, const s::bitset<IZ>& liberties, Player color):
-    mStones(stones), mLiberties(liberties), mColor(color) {}
-  GoStr(const GoStr& o): mStones(o.mStones), mLiberties(o.mLiberties), mColor(o.mColor) {}
-  GoStr& operator=(const GoStr& o){
-    mStones = o.mStones;
-    mLiberties = o.mLiberties;
-    mColor = o.mColor;
-    return *this;
-  }
-  GoStr(GoStr&& o) noexcept : mStones(s::move(o.mStones)), mLiberties(s::move(o.mLiberties)), mColor(o.mColor) {}
-  GoStr& operator=(GoStr&& o) noexcept {
-    mStones = s::move(o.mStones);
-    mLiberties = s::move(o.mLiberties);
-    mColor = o.mColor;
-    return *this;
-  }
+  GoStr(): mHash(EMPTY_BOARD), mColor(Player::Unknown){}
+  GoStr(const s::bitset<IZ>& stones, const s::bitset<IZ>& liberties, Player color, uint64 hash = EMPTY_BOARD):
+    mStones(stones), mLiberties(liberties), mHash(hash), mColor(color) {}
 
   Player color() const { return mColor; }
+  uint64 hash() const { return mHash; }
   const s::bitset<IZ>& stones() const { return mStones; }
   const s::bitset<IZ>& liberties() const { return mLiberties; }
   size_t num_liberties() const { return mLiberties.count(); }
 
   void add_liberty(Pt pt){ mLiberties.set(index<SZ>(pt)); }
+  void add_liberty(uint idx){ mLiberties.set(idx); }
   void remove_liberty(Pt pt){ mLiberties.reset(index<SZ>(pt)); }
   void merge(const GoStr& b){
     assert(mColor == b.mColor);
 
     mStones   |= b.mStones;
     mLiberties = (mLiberties | b.mLiberties) & ~mStones;
+    mHash     ^= b.mHash;
   }
 };
 
@@ -79,118 +85,100 @@ template <ubyte SZ>
 
   s::bitset<SZ> stones = a.stones() | b.stones();
   s::bitset<SZ> liberties = (a.liberties() | b.liberties()) & ~stones;
-  return GoStr<SZ>(stones, liberties, a.color());
+  return GoStr<SZ>(stones, liberties, a.color(), a.hash() ^ b.hash());
 }
 
-template <ubyte SZ> struct GoAreaScore;
+template <ubyte SZ> struct GoBoard;
+template <ubyte SZ, typename Board = GoBoard<SZ>> struct GoAreaScore;
 
 template <ubyte SZ>
 struct GoBoard : Board<GoBoard<SZ>> {
   friend struct GoAreaScore<SZ>;
-  static constexpr uint SIZE   = SZ;
-  static constexpr uint IZ     = SZ * SZ;
-  static constexpr udyte EMPTY = 0xFFFFU;
+  static constexpr uint SIZE    = SZ;
+  static constexpr uint IZ      = SZ * SZ;
+  static constexpr uint PZ      = PaddedGrid<SZ>::PZ;
+  static constexpr udyte EMPTY  = 0xFFFFU;
+  static constexpr udyte BORDER = 0xFFFEU;
+
+  using Grid = PaddedGrid<SZ>;
+
+  //before-image of everything place_stone modifies, strings are saved on
+  //first write only
+  struct Undo {
+    s::array<udyte, PZ>                  board;
+    s::vector<s::pair<udyte, GoStr<SZ>>> strings;
+    s::bitset<IZ>                        saved;
+    size_t                               nstrings;
+    uint64                               hash;
+
+    Undo(): nstrings(0), hash(EMPTY_BOARD) {}
+  };
 private:
-  bag<GoStr<SZ>>      mStrings;
-  s::array<udyte, IZ> mBoard;
-  uint                mHash;
+  //every string needs a liberty, but strings of alternating colors can cover
+  //more than half the board, and a self capture is kept until rule checking
+  fixed_bag<GoStr<SZ>, IZ> mStrings;
+  s::array<udyte, PZ>      mBoard;   //string index per cell of the padded grid
+  uint64              mHash;
 protected:
   udyte get_string_idx(Pt pt) const {
     assert(is_on_grid(pt));
 
-    return mBoard[index<SZ>(pt)];
+    return mBoard[padded_index<SZ>(pt)];
+  }
+  void save_string(Undo* undo, size_t sidx){
+    if (undo == nullptr || sidx >= undo->nstrings || undo->saved.test(sidx)) return;
+    undo->saved.set(sidx);
+    undo->strings.emplace_back(sidx, mStrings[sidx]);
   }
-  //TODO: this operation takes 21% of total computational time
   //TODO: interface redesign, does it really need both index and string ref ?
   void replace_string(const GoStr<SZ>& string, udyte index){
-    const s::bitset<IZ>& stones = string.stones();
-    for (uint i = 0; i < IZ; ++i)
-      if (stones.test(i))
-        mBoard[i] = index;
+    for_each_set_bit(string.stones(), [&](uint i){
+      mBoard[Grid::TO_PADDED[i]] = index;
+    });
   }
   //TODO: interface redesign, does it really need both index and string ref ?
-  void remove_string(const GoStr<SZ>& string, uint index){
-    const s::bitset<IZ>& stones = string.stones();
-    for (uint i = 0; i < IZ; ++i)
-      if (stones.test(i)){
-        Pt pt = point<SZ>(i);
-        Neighbours ns = neighbours(pt);
-        for (Pt neighbour : ns){
-          if (not is_on_grid(neighbour)) continue;
-
-          uint sidx = get_string_idx(neighbour);
-          if (sidx == EMPTY) continue;
-          if (sidx != index)
-            mStrings[sidx].add_liberty(pt);
-        }
-        mBoard[i] = EMPTY;
-
-        mHash ^= zobrist_hash<SZ>(string.color(), pt);
+  void remove_string(const GoStr<SZ>& string, uint index, Undo* undo = nullptr){
+    for_each_set_bit(string.stones(), [&](uint i){
+      uint p = Grid::TO_PADDED[i];
+      for (sint offset : Grid::NEIGHBOURS){
+        uint sidx = mBoard[p + offset];
+        //empty and border cells are both above any string index
+        if (sidx >= BORDER || sidx == index) continue;
+        save_string(undo, sidx);
+        mStrings[sidx].add_liberty(i);
       }
+      mBoard[p] = EMPTY;
+    });
+    mHash ^= string.hash();
     //TODO: seems like pop and replace_string should always go together,
     //      should place them together
+    save_string(undo, index);
+    save_string(undo, mStrings.size() - 1);
     mStrings.pop(index);
     if (index < mStrings.size())
       replace_string(mStrings[index], index);
   }
-public:
-  GoBoard(): mHash(EMPTY_BOARD) {
-    s::memset(mBoard.data(), 0xFFU, sizeof(udyte) * IZ);
-  }
-  GoBoard(const GoBoard& o): mStrings(o.mStrings), mBoard(o.mBoard), mHash(o.mHash) {}
-  GoBoard& operator=(const GoBoard& o){
-    mStrings = o.mStrings;
-    mBoard   = o.mBoard;
-    mHash    = o.mHash;
-    return *this;
-  }
-  GoBoard(GoBoard&& o) noexcept : mStrings(s::move(o.mStrings)), mBoard(s::move(o.mBoard)), mHash(o.mHash) {}
-  GoBoard& operator=(GoBoard&& o) noexcept {
-    mStrings = s::move(o.mStrings);
-    mBoard   = s::move(o.mBoard);
-    mHash    = o.mHash;
-    return *this;
-  }
-
-  uint size() const { return SZ; }
-  uint hash() const { return mHash; }
-  bool is_on_grid(Pt pt) const { return (pt.r < SZ && pt.c < SZ); }
-  Player get(Pt pt) const {
-    assert(is_on_grid(pt));
-
-    uint idx = get_string_idx(pt);
-    if (idx == EMPTY) return Player::Unknown;
-    else              return mStrings[idx].color();
-  }
-  const GoStr<SZ>* get_string(Pt pt) const {
-    assert(is_on_grid(pt));
-
-    uint idx = get_string_idx(pt);
-    if (idx == EMPTY) return nullptr;
-    else              return &mStrings[idx];
-  }
   //TODO: place_stone is the slowest and the most popular operation, this takes up 33% of total time
-  void place_stone(Player player, Pt pt){
+  void place_stone(Player player, Pt pt, Undo* undo){
     assert(is_on_grid(pt));
     assert(get_string_idx(pt) == EMPTY);
 
-    mHash ^= zobrist_hash<SZ>(player, pt);
+    uint64 stone_hash = zobrist_hash<SZ>(player, pt);
+    mHash ^= stone_hash;
 
     Player oplayer = other_player(player);
-    Neighbours ns = neighbours(pt);
+    uint p = padded_index<SZ>(pt);
     s::bitset<IZ> liberties;
     s::array<udyte, 4> adj_same_color;
     s::array<udyte, 4> adj_oppo_color;
     decltype(s::begin(adj_same_color)) adj_same_iter = s::begin(adj_same_color);
     decltype(s::begin(adj_oppo_color)) adj_oppo_iter = s::begin(adj_oppo_color);
 
-    for (Pt neighbour : ns){
-      if (not is_on_grid(neighbour)) continue;
-
-      uint sidx = get_string_idx(neighbour);
+    for (sint offset : Grid::NEIGHBOURS){
+      uint sidx = mBoard[p + offset];
       if (sidx == EMPTY)
-        liberties.set(index<SZ>(neighbour));
-      else if (mStrings[sidx].color() == player)
+        liberties.set(Grid::TO_INDEX[p + offset]);
+      else if (sidx != BORDER && mStrings[sidx].color() == player)
         *(adj_same_iter++) = sidx;
     }
     s::sort(s::begin(adj_same_color), adj_same_iter, s::greater<uint>());
@@ -198,23 +186,24 @@ public:
 
     //merge all same color string together
     s::bitset<IZ> stones; stones.set(index<SZ>(pt));
-    GoStr<SZ> new_string(stones, liberties, player);
+    GoStr<SZ> new_string(stones, liberties, player, stone_hash);
     for (decltype(s::begin(adj_same_color)) it = s::begin(adj_same_color); it != adj_same_iter; ++it){
       new_string.merge(mStrings[*it]);
       //TODO: seems like pop and replace_string should always go together,
       //      should place them together
+      save_string(undo, *it);
+      save_string(undo, mStrings.size() - 1);
       mStrings.pop(*it);
       if (*it < mStrings.size())
         replace_string(mStrings[*it], *it);
     }
+    save_string(undo, mStrings.size());
     udyte new_index = mStrings.push_back(new_string);
     replace_string(new_string, new_index);
 
-    for (Pt neighbour : ns){
-      if (not is_on_grid(neighbour)) continue;
-
-      uint sidx = get_string_idx(neighbour);
-      if (sidx != EMPTY && mStrings[sidx].color() == oplayer)
+    for (sint offset : Grid::NEIGHBOURS){
+      uint sidx = mBoard[p + offset];
+      if (sidx < BORDER && mStrings[sidx].color() == oplayer)
         *(adj_oppo_iter++) = sidx;
     }
     s::sort(s::begin(adj_oppo_color), adj_oppo_iter, s::greater<uint>());
@@ -222,14 +211,102 @@ public:
 
     //remove opponent dead string
     for (decltype(s::begin(adj_oppo_color)) it = s::begin(adj_oppo_color); it != adj_oppo_iter; ++it){
+      save_string(undo, *it);
       GoStr<SZ>& string = mStrings[*it];
       string.remove_liberty(pt);
       if (string.num_liberties() == 0)
-        remove_string(string, *it);
+        remove_string(string, *it, undo);
     }
     //not removing new merged string here, allow board to show self capture
     //happened for rule checking
   }
+public:
+  GoBoard(): mHash(EMPTY_BOARD) {
+    s::fill(s::begin(mBoard), s::end(mBoard), BORDER);
+    for (udyte p : Grid::TO_PADDED)
+      mBoard[p] = EMPTY;
+  }
+
+  uint size() const { return SZ; }
+  uint64 hash() const { return mHash; }
+  bool is_on_grid(Pt pt) const { return (pt.r < SZ && pt.c < SZ); }
+  Player get(Pt pt) const {
+    assert(is_on_grid(pt));
+
+    uint idx = get_string_idx(pt);
+    if (idx == EMPTY) return Player::Unknown;
+    else              return mStrings[idx].color();
+  }
+  //color of a cell of the padded grid, 0 for border cells
+  ubyte color_code(uint p) const {
+    assert(p < PZ);
+
+    uint idx = mBoard[p];
+    if      (idx == EMPTY)  return (ubyte)Player::Unknown;
+    else if (idx == BORDER) return 0U;
+    else                    return (ubyte)mStrings[idx].color();
+  }
+  const GoStr<SZ>* get_string(Pt pt) const {
+    assert(is_on_grid(pt));
+
+    uint idx = get_string_idx(pt);
+    if (idx == EMPTY) return nullptr;
+    else              return &mStrings[idx];
+  }
+  //whether placing a stone at empty pt leaves its string without liberty,
+  //decided from the neighbouring strings without a trial board
+  bool is_self_capture(Player player, Pt pt) const {
+    assert(get_string_idx(pt) == EMPTY);
+
+    uint p = padded_index<SZ>(pt);
+    for (sint offset : Grid::NEIGHBOURS){
+      uint sidx = mBoard[p + offset];
+      if (sidx == BORDER) continue;
+      if (sidx == EMPTY) return false;
+      size_t liberties = mStrings[sidx].num_liberties();
+      if (mStrings[sidx].color() == player){
+        if (liberties > 1) return false;
+      } else if (liberties == 1)
+        return false;
+    }
+    return true;
+  }
+  //board hash after placing a stone at empty pt, including captured stones
+  uint64 hash_after_move(Player player, Pt pt) const {
+    assert(get_string_idx(pt) == EMPTY);
+
+    uint64 hash = mHash ^ zobrist_hash<SZ>(player, pt);
+    uint p = padded_index<SZ>(pt);
+    s::array<udyte, 4> captured;
+    decltype(s::begin(captured)) captured_iter = s::begin(captured);
+    for (sint offset : Grid::NEIGHBOURS){
+      udyte sidx = mBoard[p + offset];
+      if (sidx >= BORDER || mStrings[sidx].color() == player || mStrings[sidx].num_liberties() != 1) continue;
+      if (s::find(s::begin(captured), captured_iter, sidx) != captured_iter) continue;
+      *(captured_iter++) = sidx;
+      hash ^= mStrings[sidx].hash();
+    }
+    return hash;
+  }
+  void place_stone(Player player, Pt pt){
+    place_stone(player, pt, nullptr);
+  }
+  //place stone and record what is needed to take it back with undo()
+  void place_stone(Player player, Pt pt, Undo& undo){
+    undo.board    = mBoard;
+    undo.strings.clear();
+    undo.saved.reset();
+    undo.nstrings = mStrings.size();
+    undo.hash     = mHash;
+    place_stone(player, pt, &undo);
+  }
+  void undo(const Undo& undo){
+    mStrings.resize(undo.nstrings);
+    for (const s::pair<udyte, GoStr<SZ>>& saved : undo.strings)
+      mStrings[saved.first] = saved.second;
+    mBoard = undo.board;
+    mHash  = undo.hash;
+  }
 
   s::ostream& print(s::ostream& out) const {
     char bchar = 'X';
@@ -302,14 +379,28 @@ constexpr float default_komi(){
   else                                   return 7.5F;
 }
 
+//stones of each color as bit planes, read point by point. boards that keep
+//bit planes specialize this
+template <ubyte SZ, typename Board>
+struct StonePlanes {
+  void operator()(const Board& board, BitPlane<SZ>& black, BitPlane<SZ>& white){
+    for (uint i = 0; i < SZ * SZ; ++i)
+      switch (board.get(point<SZ>(i))){
+      case Player::Black: black.set(i); break;
+      case Player::White: white.set(i); break;
+      default:;
+      }
+  }
+};
+
 // scoring using area rule: player pieces on board + territory + komi
-template <ubyte SZ>
+template <ubyte SZ, typename Board>
 struct GoAreaScore {
   static constexpr uint SIZE = SZ;
   static constexpr uint IZ = SZ * SZ;
   static constexpr ubyte DAME = (ubyte) Player::White | (ubyte) Player::Black;
 private:
-  const GoBoard<SZ>& mBoard;
+  const Board&       mBoard;
   float              mBlackPoints;
   float              mBlackTerritory;
   float              mWhitePoints;
@@ -317,67 +408,59 @@ private:
   float              mDames;
   float              mKomi;
 protected:
+  //empty regions split by the colors bordering them, a region bordered by
+  //both colors or by none is dame
+  struct Territory {
+    BitPlane<SZ> black;
+    BitPlane<SZ> white;
+    BitPlane<SZ> dame;
+  };
+
+  //labels one empty region per iteration by flood fill over the empty plane
+  static Territory create_territory(const BitPlane<SZ>& black, const BitPlane<SZ>& white){
+    Territory ret;
+    BitPlane<SZ> empty = BitMasks<SZ>::FULL.andnot(black | white);
+    BitPlane<SZ> unlabeled = empty;
+    while (unlabeled.any()){
+      BitPlane<SZ> seed;
+      seed.set(unlabeled.first());
+      BitPlane<SZ> region = flood_fill(seed, empty);
+      BitPlane<SZ> border = adjacent(region);
+      bool by_black = (border & black).any();
+      bool by_white = (border & white).any();
+      if      (by_black && not by_white) ret.black |= region;
+      else if (by_white && not by_black) ret.white |= region;
+      else                               ret.dame  |= region;
+      unlabeled = unlabeled.andnot(region);
+    }
+    return ret;
+  }
+
   s::array<ubyte, IZ> create_territory_labeling(){
-    struct Recursion {
-      Recursion(const GoBoard<SZ>& board): board(board) {}
-      ubyte operator()(Pt spt, s::bitset<IZ>& points){
-        points.set(index<SZ>(spt));
-        ubyte coloring = 0;
-        for (Pt neighbour : neighbours(spt)){
-          if (not board.is_on_grid(neighbour)) continue;
-          Player color = board.get(neighbour);
-          if ((not points.test(index<SZ>(neighbour))) && color == Player::Unknown){
-            ubyte rret = this->operator()(neighbour, points);
-            coloring |= rret;
-          } else if (color != Player::Unknown){
-            coloring |= (ubyte)color;
-          }
-        }
-        if (coloring == 0) return DAME;
-        else               return coloring;
-      }
-    private:
-      const GoBoard<SZ>& board;
-    } recursive_labeling(mBoard);
+    BitPlane<SZ> black, white;
+    StonePlanes<SZ, Board>()(mBoard, black, white);
+    Territory territory = create_territory(black, white);
 
     s::array<ubyte, IZ> labels;
     s::memset(labels.data(), 0U, sizeof(ubyte) * IZ);
-    for (uint i = 0; i < IZ; ++i){
-      Pt pt = point<SZ>(i);
-      if (mBoard.get(pt) == Player::Unknown && labels[i] == 0U){
-        s::bitset<IZ> points;
-        ubyte coloring = recursive_labeling(pt, points);
-        for (uint i = 0; i < IZ; ++i)
-          if (points.test(i))
-            labels[i] = coloring;
-      }
-    }
+    territory.black.for_each([&](uint i){ labels[i] = (ubyte)Player::Black; });
+    territory.white.for_each([&](uint i){ labels[i] = (ubyte)Player::White; });
+    territory.dame.for_each([&](uint i){ labels[i] = DAME; });
     return labels;
   }
 
-  void compute_score(const s::array<ubyte, IZ>& labels){
-    for (uint i = 0; i < IZ; ++i){
-      Pt pt = point<SZ>(i);
-      Player color = mBoard.get(pt);
-      switch (color){
-      case Player::Black: mBlackPoints++; break;
-      case Player::White: mWhitePoints++; break;
-      case Player::Unknown:
-        switch (labels[i]){
-        case (ubyte)Player::Black: mBlackTerritory++; break;
-        case (ubyte)Player::White: mWhiteTerritory++; break;
-        case DAME:          mDames++;          break;
-        default: assert(false);
-        }
-        break;
-      default: assert(false);
-      }
-    }
+  void compute_score(const BitPlane<SZ>& black, const BitPlane<SZ>& white, const Territory& territory){
+    mBlackPoints    = black.count();
+    mWhitePoints    = white.count();
+    mBlackTerritory = territory.black.count();
+    mWhiteTerritory = territory.white.count();
+    mDames          = territory.dame.count();
   }
 
   void compute_winner(){
-    s::array<ubyte, IZ> labels = create_territory_labeling();
-    compute_score(labels);
+    BitPlane<SZ> black, white;
+    StonePlanes<SZ, Board>()(mBoard, black, white);
+    compute_score(black, white, create_territory(black, white));
   }
 
   bool is_winner_computed(){
@@ -387,7 +470,7 @@ protected:
       return true;
   }
 public:
-  explicit GoAreaScore(const GoBoard<SZ>& board, float komi = 7.5):
+  explicit GoAreaScore(const Board& board, float komi = 7.5):
     mBoard(board),
     mBlackPoints(0.F), mBlackTerritory(0.F),
     mWhitePoints(0.F), mWhiteTerritory(0.F),
@@ -404,33 +487,148 @@ public:
     if (not is_winner_computed()) compute_winner();
     return mBlackPoints - mWhitePoints + mBlackTerritory - mWhiteTerritory - mKomi;
   }
+
+  //score a batch of final positions, writes the winning margin of each board
+  //in [first, last) to out
+  template <typename Iter, typename OutIter>
+  static OutIter winning_margins(Iter first, Iter last, OutIter out, float komi){
+    for (; first != last; ++first, ++out){
+      BitPlane<SZ> black, white;
+      StonePlanes<SZ, Board>()(*first, black, white);
+      Territory territory = create_territory(black, white);
+      *out = (float)black.count() - (float)white.count() + (float)territory.black.count() - (float)territory.white.count() - komi;
+    }
+    return out;
+  }
 };
 
+// position hashes of a game shared between game states. the hashes form a
+// chain from the latest position back to the first one, copying a history
+// copies the chain head pointer and a bloom filter of the hashes, which turns
+// away most lookups without walking the chain
 template <ubyte SZ>
-struct GoGameState : GameState<GoBoard<SZ>, GoGameState<SZ>> {
+class GoHistory {
+  static constexpr uint filter_bits(){
+    uint bits = 64;
+    while (bits < SZ * SZ * 16) bits <<= 1;
+    return bits;
+  }
+  static constexpr uint FILTER_BITS = filter_bits();
+
+  struct Node {
+    uint64                    hash;
+    s::shared_ptr<const Node> parent;
+
+    Node(uint64 hash, const s::shared_ptr<const Node>& parent): hash(hash), parent(parent) {}
+  };
+
+  s::shared_ptr<const Node> mHead;
+  s::bitset<FILTER_BITS>    mFilter;
+  size_t                    mSize;
+
+  //zobrist keys are uniformly random, two slices of the hash serve as the
+  //two filter probes
+  static uint probe1(uint64 hash){ return hash & (FILTER_BITS - 1); }
+  static uint probe2(uint64 hash){ return (hash >> 32) & (FILTER_BITS - 1); }
+public:
+  GoHistory(): mSize(0) {}
+
+  size_t size() const { return mSize; }
+  bool contains(uint64 hash) const {
+    if (not mFilter.test(probe1(hash)) || not mFilter.test(probe2(hash))) return false;
+    for (const Node* node = mHead.get(); node != nullptr; node = node->parent.get())
+      if (node->hash == hash) return true;
+    return false;
+  }
+  //returns false if hash is already in the history. added gets the filter
+  //probes the insert turned on, bit 0 for the first and bit 1 for the second
+  bool insert(uint64 hash, ubyte& added){
+    added = 0U;
+    if (contains(hash)) return false;
+    mHead = s::make_shared<const Node>(hash, mHead);
+    if (not mFilter.test(probe1(hash))){
+      mFilter.set(probe1(hash));
+      added |= 1U;
+    }
+    if (not mFilter.test(probe2(hash))){
+      mFilter.set(probe2(hash));
+      added |= 2U;
+    }
+    mSize++;
+    return true;
+  }
+  bool insert(uint64 hash){
+    ubyte added;
+    return insert(hash, added);
+  }
+  //remove the latest inserted hash. added is what its insert reported, the
+  //filter bits it names are turned off again. bits left set only cost a
+  //chain walk on a false positive, but a state walked up and down the tree
+  //would collect them until every lookup walks the chain
+  void pop(ubyte added = 0U){
+    assert(mHead);
+
+    if (added & 1U) mFilter.reset(probe1(mHead->hash));
+    if (added & 2U) mFilter.reset(probe2(mHead->hash));
+    mHead = mHead->parent;
+    mSize--;
+  }
+
+  bool operator==(const GoHistory& o) const {
+    if (mSize != o.mSize) return false;
+    const Node* a = mHead.get();
+    const Node* b = o.mHead.get();
+    //shared tails are equal from the first shared node on
+    for (; a != b; a = a->parent.get(), b = b->parent.get())
+      if (a->hash != b->hash) return false;
+    return true;
+  }
+  bool operator!=(const GoHistory& o) const {
+    return not operator==(o);
+  }
+};
+
+// Board is the string storage policy, GoBoard or GoChainBoard
+template <ubyte SZ, typename Board = GoBoard<SZ>>
+struct GoGameState : GameState<Board, GoGameState<SZ, Board>> {
   static constexpr uint SIZE = SZ;
   static constexpr uint IZ = SZ * SZ;
 
+  using MoveMask = s::bitset<IZ + 1>;
+
+  //everything apply_move changes, so undo_move can take it back
+  struct Undo {
+    typename Board::Undo board;
+    Player               nplayer;
+    Move                 pmove;
+    Move                 ppmove;
+    bool                 inserted; //whether the move added a new hash into history
+    ubyte                filter;   //history filter bits the insert turned on
+
+    Undo(): nplayer(Player::Unknown), pmove(M::Unknown), ppmove(M::Unknown), inserted(false), filter(0U) {}
+  };
 protected:
-  GoBoard<SZ>            mBoard;
+  Board                  mBoard;
   Player                 mNPlayer; //next player
   Move                   mPMove;   //previous move
   Move                   mPPMove;  //previous previous move
-  s::unordered_set<uint> mHistory; //zobrist hash history
+  GoHistory<SZ>          mHistory; //zobrist hash history
 protected:
   //self capture is optionally allowed in Go, but we assume it is always bad
   //and prune
   bool is_move_self_capture(Move move) const {
     if (move.mty != M::Play) return false;
-    GoBoard<SZ> test_board = mBoard;
-    test_board.place_stone(mNPlayer, move.mpt);
-    const GoStr<SZ>* string = test_board.get_string(move.mpt);
-    return string->num_liberties() == 0;
+    return mBoard.is_self_capture(mNPlayer, move.mpt);
+  }
+  BitPlane<SZ> empty_plane() const {
+    BitPlane<SZ> black, white;
+    StonePlanes<SZ, Board>()(mBoard, black, white);
+    return BitMasks<SZ>::FULL.andnot(black | white);
   }
 public:
   GoGameState():
     mBoard(), mNPlayer(Player::Black), mPMove(M::Unknown), mPPMove(M::Unknown), mHistory() {}
-  GoGameState(const GoBoard<SZ>& board, Player player, Move pmove, Move ppmove, const s::unordered_set<uint>& history):
+  GoGameState(const Board& board, Player player, Move pmove, Move ppmove, const GoHistory<SZ>& history):
     mBoard(board), mNPlayer(player), mPMove(pmove), mPPMove(ppmove), mHistory(history) {}
   GoGameState(const GoGameState& o):
     mBoard(o.mBoard), mNPlayer(o.mNPlayer), mPMove(o.mPMove), mPPMove(o.mPPMove), mHistory(o.mHistory) {}
@@ -458,7 +656,7 @@ public:
     return *this;
   }
 
-  const GoBoard<SZ>& board() const { return mBoard; }
+  const Board& board() const { return mBoard; }
   Player next_player() const { return mNPlayer; }
   Move previous_move() const { return mPMove; }
 
@@ -470,9 +668,7 @@ public:
   }
   bool does_move_violate_ko(Move move) const {
     if (move.mty != M::Play) return false;
-    GoBoard<SZ> test_board = mBoard;
-    test_board.place_stone(mNPlayer, move.mpt);
-    return mHistory.find(test_board.hash()) != s::end(mHistory);
+    return mHistory.contains(mBoard.hash_after_move(mNPlayer, move.mpt));
   }
   //TODO: zero does not need to check if a move is self capture,
   //      we can create a weaker version that does not do self capture check
@@ -518,10 +714,64 @@ public:
     ret.push_back(Move(M::Resign));
     return ret;
   }
+  //legal moves as a mask indexed by point index, bit IZ is pass. resign is
+  //always legal and not part of the mask. only the empty points are visited,
+  //an empty point next to another one has a liberty and cannot be self
+  //capture, the rest are checked one by one, as is ko for all of them
+  MoveMask legal_moves_mask() const {
+    MoveMask ret;
+    if (is_over()) return ret;
+    BitPlane<SZ> empty = empty_plane();
+    BitPlane<SZ> breathing = empty & touching(empty);
+    empty.for_each([&](uint i){
+      Pt pt = point<SZ>(i);
+      if ((breathing.test(i) || not mBoard.is_self_capture(mNPlayer, pt)) &&
+          not mHistory.contains(mBoard.hash_after_move(mNPlayer, pt)))
+        ret.set(i);
+    });
+    ret.set(IZ);
+    return ret;
+  }
+  MoveMask relaxed_legal_moves_mask() const {
+    MoveMask ret;
+    if (is_over()) return ret;
+    empty_plane().for_each([&](uint i){
+      if (not mHistory.contains(mBoard.hash_after_move(mNPlayer, point<SZ>(i))))
+        ret.set(i);
+    });
+    ret.set(IZ);
+    return ret;
+  }
+  //point the next player cannot play because it retakes the single stone
+  //that just captured in a ko
+  s::optional<Pt> ko_point() const {
+    if (mPMove.mty != M::Play || mBoard.get(mPMove.mpt) != other_player(mNPlayer)) return s::nullopt;
+    s::optional<Pt> liberty;
+    for (Pt neighbour : neighbours(mPMove.mpt)){
+      if (not mBoard.is_on_grid(neighbour)) continue;
+
+      Player color = mBoard.get(neighbour);
+      if (color == other_player(mNPlayer)) return s::nullopt;
+      if (color == Player::Unknown){
+        if (liberty) return s::nullopt;
+        liberty = neighbour;
+      }
+    }
+    if (liberty && does_move_violate_ko(Move(M::Play, *liberty))) return liberty;
+    return s::nullopt;
+  }
+  //position key for transposition tables, the board hash plus the side to
+  //move and the ko point
+  uint64 key() const {
+    uint64 ret = mBoard.hash() ^ zobrist_side_hash(mNPlayer);
+    s::optional<Pt> ko = ko_point();
+    if (ko) ret ^= zobrist_ko_hash<SZ>(*ko);
+    return ret;
+  }
   Player winner(){
     if (not is_over()) return Player::Unknown;
     if (mPMove.mty == M::Resign) return mNPlayer;
-    GoAreaScore<SZ> scorer(mBoard, default_komi<SZ>());
+    GoAreaScore<SZ, Board> scorer(mBoard, default_komi<SZ>());
     return scorer.winner();
   }
   GoGameState& apply_move(Move move){
@@ -534,6 +784,33 @@ public:
     mNPlayer = other_player(mNPlayer);
     return *this;
   }
+  //apply move in place and record how to revert it, so search can walk a
+  //single state down and back up the tree instead of copying it
+  GoGameState& apply_move(Move move, Undo& undo){
+    undo.nplayer  = mNPlayer;
+    undo.pmove    = mPMove;
+    undo.ppmove   = mPPMove;
+    undo.inserted = false;
+    mPPMove = mPMove;
+    mPMove = move;
+    if (move.mty == M::Play){
+      mBoard.place_stone(mNPlayer, move.mpt, undo.board);
+      undo.inserted = mHistory.insert(mBoard.hash(), undo.filter);
+    }
+    mNPlayer = other_player(mNPlayer);
+    return *this;
+  }
+  //undo records must be reverted in the reverse order they are applied
+  void undo_move(const Undo& undo){
+    if (mPMove.mty == M::Play){
+      if (undo.inserted)
+        mHistory.pop(undo.filter);
+      mBoard.undo(undo.board);
+    }
+    mNPlayer = undo.nplayer;
+    mPMove   = undo.pmove;
+    mPPMove  = undo.ppmove;
+  }
 };
 
 } //rlgames
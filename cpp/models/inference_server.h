@@ -0,0 +1,161 @@
+#ifndef RLGAMES_INFERENCE_SERVER
+#define RLGAMES_INFERENCE_SERVER
+
+#include <cassert>
+#include <array>
+#include <vector>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <atomic>
+#include <exception>
+
+#include <type_alias.h>
+#include <mpmc_queue.h>
+#include <pytorch_util.h>
+
+#include <torch/torch.h>
+
+namespace rlgames {
+
+namespace s = std;
+namespace t = torch;
+
+//value and move priors of one position
+template <uint BF>
+struct Evaluation {
+  float               value;
+  s::array<float, BF> priors;
+};
+
+// runs the model of many game threads on one thread of its own. a game thread
+// queues an encoded position and gets a future of its evaluation, the server
+// collects queued positions into a batch until it holds max_batch of them or
+// timeout has passed since the first, runs one forward pass over the batch
+// and fulfils the futures. an exception of the forward pass is passed to the
+// futures of its batch and the server keeps serving. the model must not be
+// used elsewhere while the server is running, except when no game thread is
+// waiting on it
+template <typename Model, uint BF>
+class InferenceServer {
+  using Clock = s::chrono::steady_clock;
+  static constexpr uint IDLE_SPINS = 64; //yields on an empty queue before sleeping
+
+  struct Request {
+    TensorP                    state;
+    s::promise<Evaluation<BF>> result;
+  };
+
+  Model&                  mModel;
+  uint                    mMaxBatch;
+  s::chrono::microseconds mTimeout;
+  mpmc_queue<Request>     mQueue;
+  s::atomic<bool>         mStop;
+  s::atomic<uint64>       mBatches;
+  s::atomic<uint64>       mRequests;
+  s::thread               mThread;
+
+  void run(s::vector<Request>& batch){
+    s::vector<t::Tensor> boards, states;
+    boards.reserve(batch.size());
+    states.reserve(batch.size());
+    for (Request& request : batch){
+      boards.push_back(request.state.x);
+      states.push_back(request.state.y);
+    }
+    long size = batch.size();
+    t::NoGradGuard no_grad;
+    TensorP avout = mModel.model->forward(TensorP(t::stack(boards), t::stack(states)));
+    t::Tensor priors = avout.x.reshape({size, (long)BF}).to(t::Device(t::kCPU)).contiguous();
+    t::Tensor values = avout.y.reshape({size}).to(t::Device(t::kCPU)).contiguous();
+    float* prior_ptr = (float*)priors.data_ptr();
+    float* value_ptr = (float*)values.data_ptr();
+    for (long i = 0; i < size; ++i){
+      Evaluation<BF> eval;
+      eval.value = value_ptr[i];
+      s::copy(prior_ptr + i * BF, prior_ptr + (i + 1) * BF, s::begin(eval.priors));
+      batch[i].result.set_value(eval);
+    }
+    mBatches.fetch_add(1, s::memory_order_relaxed);
+    mRequests.fetch_add(size, s::memory_order_relaxed);
+    batch.clear();
+  }
+
+  void serve(){
+    s::vector<Request> batch;
+    batch.reserve(mMaxBatch);
+    Request request;
+    uint idle = 0;
+    while (true){
+      if (not mQueue.try_pop(request)){
+        //requests queued before stop are still answered
+        if (mStop.load(s::memory_order_acquire) && mQueue.size_approx() == 0) break;
+        if (idle++ < IDLE_SPINS) s::this_thread::yield();
+        else                     s::this_thread::sleep_for(s::chrono::microseconds(50));
+        continue;
+      }
+      idle = 0;
+      batch.push_back(s::move(request));
+      Clock::time_point deadline = Clock::now() + mTimeout;
+      while (batch.size() < mMaxBatch){
+        if (mQueue.try_pop(request))
+          batch.push_back(s::move(request));
+        else if (Clock::now() >= deadline)
+          break;
+        else
+          s::this_thread::yield();
+      }
+      try {
+        run(batch);
+      } catch (...){
+        //the forward pass failed before any result was set, every game
+        //thread of the batch gets the exception from its future
+        s::exception_ptr error = s::current_exception();
+        for (Request& failed : batch)
+          failed.result.set_exception(error);
+        batch.clear();
+      }
+    }
+  }
+public:
+  InferenceServer(Model& model, uint max_batch, s::chrono::microseconds timeout, size_t queue_size = 1024):
+    mModel(model),
+    mMaxBatch(max_batch),
+    mTimeout(timeout),
+    mQueue(queue_size),
+    mStop(false),
+    mBatches(0),
+    mRequests(0){
+    assert(max_batch > 0);
+
+    mThread = s::thread(&InferenceServer::serve, this);
+  }
+  InferenceServer(const InferenceServer&) = delete;
+  InferenceServer& operator=(const InferenceServer&) = delete;
+  ~InferenceServer(){
+    mStop.store(true, s::memory_order_release);
+    mThread.join();
+  }
+
+  //state is one position as the state encoder gives it, on the device of
+  //the model
+  s::future<Evaluation<BF>> evaluate(TensorP state){
+    Request request;
+    request.state = s::move(state);
+    s::future<Evaluation<BF>> ret = request.result.get_future();
+    while (not mQueue.try_push(s::move(request)))
+      s::this_thread::yield();
+    return ret;
+  }
+
+  uint64 batches() const { return mBatches.load(s::memory_order_relaxed); }
+  uint64 requests() const { return mRequests.load(s::memory_order_relaxed); }
+  float mean_batch_size() const {
+    uint64 count = batches();
+    return count == 0 ? 0.F : (float)requests() / (float)count;
+  }
+};
+
+} // rlgames
+
+#endif//RLGAMES_INFERENCE_SERVER
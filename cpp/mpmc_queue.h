@@ -0,0 +1,107 @@
+#ifndef RLGAMES_MPMC_QUEUE
+#define RLGAMES_MPMC_QUEUE
+
+#include <cassert>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include <type_alias.h>
+
+namespace s = std;
+
+namespace rlgames {
+
+// bounded lock-free queue for many producers and many consumers. each cell
+// carries a sequence number telling whether it is ready to be written or
+// read for the current lap around the ring, a thread claims a cell with a
+// compare and swap on the enqueue or dequeue position and then hands it over
+// by publishing the next sequence number. the capacity is rounded up to a
+// power of two
+template <typename T>
+class mpmc_queue {
+  static constexpr size_t CACHE_LINE = 64;
+
+  struct alignas(CACHE_LINE) Cell {
+    s::atomic<size_t> sequence;
+    T                 data;
+  };
+
+  s::unique_ptr<Cell[]>                 mCells;
+  size_t                                mMask;
+  alignas(CACHE_LINE) s::atomic<size_t> mEnqueue;
+  alignas(CACHE_LINE) s::atomic<size_t> mDequeue;
+
+  static size_t round_up(size_t capacity){
+    size_t ret = 1;
+    while (ret < capacity)
+      ret <<= 1;
+    return ret;
+  }
+public:
+  explicit mpmc_queue(size_t capacity):
+    mCells(new Cell[round_up(capacity)]), mMask(round_up(capacity) - 1), mEnqueue(0), mDequeue(0) {
+    assert(capacity > 0);
+
+    for (size_t i = 0; i <= mMask; ++i)
+      mCells[i].sequence.store(i, s::memory_order_relaxed);
+  }
+  mpmc_queue(const mpmc_queue&) = delete;
+  mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+  size_t capacity() const { return mMask + 1; }
+
+  //false if the queue is full, v is left untouched then
+  bool try_push(T&& v){
+    size_t pos = mEnqueue.load(s::memory_order_relaxed);
+    Cell* cell;
+    while (true){
+      cell = &mCells[pos & mMask];
+      size_t seq = cell->sequence.load(s::memory_order_acquire);
+      sint64 diff = (sint64)seq - (sint64)pos;
+      if (diff == 0){
+        if (mEnqueue.compare_exchange_weak(pos, pos + 1, s::memory_order_relaxed))
+          break;
+      } else if (diff < 0)
+        return false;
+      else
+        pos = mEnqueue.load(s::memory_order_relaxed);
+    }
+    cell->data = s::move(v);
+    cell->sequence.store(pos + 1, s::memory_order_release);
+    return true;
+  }
+
+  //false if the queue is empty
+  bool try_pop(T& v){
+    size_t pos = mDequeue.load(s::memory_order_relaxed);
+    Cell* cell;
+    while (true){
+      cell = &mCells[pos & mMask];
+      size_t seq = cell->sequence.load(s::memory_order_acquire);
+      sint64 diff = (sint64)seq - (sint64)(pos + 1);
+      if (diff == 0){
+        if (mDequeue.compare_exchange_weak(pos, pos + 1, s::memory_order_relaxed))
+          break;
+      } else if (diff < 0)
+        return false;
+      else
+        pos = mDequeue.load(s::memory_order_relaxed);
+    }
+    v = s::move(cell->data);
+    cell->sequence.store(pos + mMask + 1, s::memory_order_release);
+    return true;
+  }
+
+  //number of elements at some recent point, exact only when no thread is
+  //pushing or popping
+  size_t size_approx() const {
+    size_t enqueue = mEnqueue.load(s::memory_order_relaxed);
+    size_t dequeue = mDequeue.load(s::memory_order_relaxed);
+    return enqueue > dequeue ? enqueue - dequeue : 0;
+  }
+};
+
+} // rlgames
+
+#endif//RLGAMES_MPMC_QUEUE
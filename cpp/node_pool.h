@@ -0,0 +1,129 @@
+#ifndef RLGAMES_NODE_POOL
+#define RLGAMES_NODE_POOL
+
+#include <cassert>
+#include <new>
+#include <utility>
+#include <atomic>
+#include <algorithm>
+#include <type_traits>
+
+namespace s = std;
+
+namespace rlgames {
+
+// raw storage for search tree nodes. storage is allocated once and only grows,
+// nodes are constructed in place when they are handed out, and reset() only
+// destroys the nodes handed out since the last reset. nodes never move, so
+// pointers between them stay valid until reset
+template <typename T> class concurrent_node_pool;
+
+template <typename T>
+class node_pool {
+  friend class concurrent_node_pool<T>;
+
+  T*     mNodes;
+  size_t mCapacity;
+  size_t mSize;
+
+  static T* allocate(size_t capacity){
+    if (capacity == 0) return nullptr;
+    return static_cast<T*>(::operator new(sizeof(T) * capacity, s::align_val_t(alignof(T))));
+  }
+  static void deallocate(T* nodes){
+    if (nodes != nullptr)
+      ::operator delete(nodes, s::align_val_t(alignof(T)));
+  }
+public:
+  explicit node_pool(size_t capacity = 0): mNodes(allocate(capacity)), mCapacity(capacity), mSize(0) {}
+  node_pool(const node_pool&) = delete;
+  node_pool& operator=(const node_pool&) = delete;
+  node_pool(node_pool&& o) noexcept : mNodes(o.mNodes), mCapacity(o.mCapacity), mSize(o.mSize) {
+    o.mNodes = nullptr;
+    o.mCapacity = 0;
+    o.mSize = 0;
+  }
+  node_pool& operator=(node_pool&& o) noexcept {
+    s::swap(mNodes, o.mNodes);
+    s::swap(mCapacity, o.mCapacity);
+    s::swap(mSize, o.mSize);
+    return *this;
+  }
+  ~node_pool(){
+    reset();
+    deallocate(mNodes);
+  }
+
+  size_t size() const { return mSize; }
+  size_t capacity() const { return mCapacity; }
+
+  //make room for capacity nodes, only allowed on an empty pool
+  void reserve(size_t capacity){
+    assert(mSize == 0);
+
+    if (capacity <= mCapacity) return;
+    deallocate(mNodes);
+    mNodes = allocate(capacity);
+    mCapacity = capacity;
+  }
+  //destroys the nodes in use, free when T has a trivial destructor
+  void reset(){
+    if constexpr (not s::is_trivially_destructible<T>::value)
+      for (size_t i = 0; i < mSize; ++i)
+        mNodes[i].~T();
+    mSize = 0;
+  }
+
+  template <class... Args>
+  T* construct(Args&&... args){
+    assert(mSize < mCapacity);
+
+    return new (mNodes + mSize++) T(s::forward<Args>(args)...);
+  }
+};
+
+// node_pool shared by threads growing one tree. a thread claims the next slot
+// with fetch_add and constructs its node there, construct returns nullptr
+// once the pool is full. reserve and reset are not safe while other threads
+// construct
+template <typename T>
+class concurrent_node_pool {
+  node_pool<T>      mStorage; //only its storage is used, its size stays 0
+  s::atomic<size_t> mSize;
+public:
+  explicit concurrent_node_pool(size_t capacity = 0): mStorage(capacity), mSize(0) {}
+  concurrent_node_pool(const concurrent_node_pool&) = delete;
+  concurrent_node_pool& operator=(const concurrent_node_pool&) = delete;
+  ~concurrent_node_pool(){
+    reset();
+  }
+
+  size_t size() const { return s::min(mSize.load(s::memory_order_relaxed), capacity()); }
+  size_t capacity() const { return mStorage.capacity(); }
+
+  void reserve(size_t capacity){
+    assert(size() == 0);
+
+    mStorage.reserve(capacity);
+  }
+  void reset(){
+    T* nodes = data();
+    if constexpr (not s::is_trivially_destructible<T>::value)
+      for (size_t i = 0; i < size(); ++i)
+        nodes[i].~T();
+    mSize.store(0, s::memory_order_relaxed);
+  }
+
+  template <class... Args>
+  T* construct(Args&&... args){
+    size_t idx = mSize.fetch_add(1, s::memory_order_relaxed);
+    if (idx >= capacity()) return nullptr;
+    return new (data() + idx) T(s::forward<Args>(args)...);
+  }
+private:
+  T* data(){ return mStorage.mNodes; }
+};
+
+} // rlgames
+
+#endif//RLGAMES_NODE_POOL
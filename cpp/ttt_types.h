@@ -88,6 +88,15 @@ using TTTBoard = TTTBoard_<3>;
 struct TTTGameState : public GameState<TTTBoard, TTTGameState> {
   static constexpr uint SIZE = 3;
   static constexpr uint IZ = 9;
+
+  //the whole state is a few bytes, undo record just keeps a copy
+  struct Undo {
+    TTTBoard board;
+    Player   nplayer;
+    Move     pmove;
+
+    Undo(): nplayer(Player::Unknown), pmove(M::Unknown) {}
+  };
 private:
   TTTBoard mBoard;
   Player   mNPlayer;
@@ -197,6 +206,17 @@ public:
     mNPlayer = other_player(mNPlayer);
     return *this;
   }
+  TTTGameState& apply_move(Move move, Undo& undo){
+    undo.board = mBoard;
+    undo.nplayer = mNPlayer;
+    undo.pmove = mPMove;
+    return apply_move(move);
+  }
+  void undo_move(const Undo& undo){
+    mBoard = undo.board;
+    mNPlayer = undo.nplayer;
+    mPMove = undo.pmove;
+  }
 };
 
 } // rlgames
@@ -47,6 +47,46 @@ template <uint SZ>
   return s::array<Pt, 4>{Pt(p.r - 1, p.c - 1), Pt(p.r + 1, p.c - 1), Pt(p.r - 1, p.c + 1), Pt(p.r + 1, p.c + 1)};
 }
 
+// SZ x SZ grid surrounded by a one point sentinel border. cells are numbered
+// row major on the (SZ+2) x (SZ+2) grid, so every point on the board has its
+// 4 neighbours and 4 corners inside the array at fixed offsets
+template <uint SZ>
+struct PaddedGrid {
+  static constexpr uint  W   = SZ + 2;
+  static constexpr uint  IZ  = SZ * SZ;
+  static constexpr uint  PZ  = W * W;
+  static constexpr udyte OFF = 0xFFFFU;
+
+  //same order as neighbours() and corners()
+  static constexpr s::array<sint, 4> NEIGHBOURS{-(sint)W, -1, (sint)W, 1};
+  static constexpr s::array<sint, 4> CORNERS{-(sint)W - 1, (sint)W - 1, -(sint)W + 1, (sint)W + 1};
+
+  static constexpr s::array<udyte, IZ> make_to_padded(){
+    s::array<udyte, IZ> ret{};
+    for (uint i = 0; i < IZ; ++i)
+      ret[i] = (i / SZ + 1) * W + i % SZ + 1;
+    return ret;
+  }
+  static constexpr s::array<udyte, PZ> make_to_index(){
+    s::array<udyte, PZ> ret{};
+    for (uint p = 0; p < PZ; ++p){
+      uint r = p / W, c = p % W;
+      if (r == 0 || c == 0 || r == W - 1 || c == W - 1) ret[p] = OFF;
+      else                                               ret[p] = (r - 1) * SZ + c - 1;
+    }
+    return ret;
+  }
+
+  //point index to cell, cell to point index or OFF for border cells
+  static constexpr s::array<udyte, IZ> TO_PADDED = make_to_padded();
+  static constexpr s::array<udyte, PZ> TO_INDEX  = make_to_index();
+};
+
+template <uint SZ>
+[[gnu::always_inline]] inline uint padded_index(Pt p){
+  return (p.r + 1) * (SZ + 2) + p.c + 1;
+}
+
 enum class M : ubyte {
   Play    = 0x1,
   Pass    = 0x2,
@@ -0,0 +1,66 @@
+#include <cassert>
+#include <cstdlib>
+
+#include <chrono>
+#include <vector>
+#include <numeric>
+#include <iostream>
+
+#include <type_alias.h>
+#include <types.h>
+#include <go_types.h>
+#include <go_chain_board.h>
+#include <go_bitboard.h>
+#include <splitmix.h>
+#include <agents/agent_base.h>
+
+namespace s = std;
+namespace c = s::chrono;
+namespace R = rlgames;
+
+//plays the same random games on each board layout and reports the time taken
+template <typename Board, typename GameState>
+void bench(const char* name, uint games, uint seed){
+  R::Splitmix gen(seed);
+  R::IsPointAnEye<Board> is_point_an_eye;
+  s::vector<udyte> cache(Board::IZ);
+  s::iota(cache.begin(), cache.end(), 0);
+  uint64 moves = 0;
+
+  auto tstart = c::high_resolution_clock::now();
+  for (uint g = 0; g < games; ++g){
+    GameState state;
+    while (not state.is_over()){
+      s::random_shuffle(s::begin(cache), s::end(cache), [&gen](int k){ return gen() % k; });
+      bool found_move = false;
+      for (udyte index : cache){
+        R::Pt pt = R::point<Board::SIZE>(index);
+        R::Move m(R::M::Play, pt);
+        if (state.is_valid_move(m) && (not is_point_an_eye(state.board(), pt, state.next_player()))){
+          state.apply_move(m);
+          found_move = true;
+          break;
+        }
+      }
+      if (not found_move)
+        state.apply_move(R::Move(R::M::Pass));
+      moves++;
+    }
+  }
+  auto tstop = c::high_resolution_clock::now();
+  auto duration = c::duration_cast<c::microseconds>(tstop - tstart);
+
+  s::cout << name << ": " << games << " games, " << moves << " moves, " << duration.count() << " microseconds" << s::endl;
+}
+
+int main(int argc, const char* argv[]){
+  uint games = 100;
+  if (argc > 1) games = atoi(argv[1]);
+
+  bench<R::GoBoard<9>, R::GoGameState<9>>("GoBoard<9>", games, 17);
+  bench<R::GoChainBoard<9>, R::GoChainGameState<9>>("GoChainBoard<9>", games, 17);
+  bench<R::GoBitBoard<9>, R::GoBitGameState<9>>("GoBitBoard<9>", games, 17);
+  bench<R::GoBoard<19>, R::GoGameState<19>>("GoBoard<19>", games, 17);
+  bench<R::GoChainBoard<19>, R::GoChainGameState<19>>("GoChainBoard<19>", games, 17);
+  bench<R::GoBitBoard<19>, R::GoBitGameState<19>>("GoBitBoard<19>", games, 17);
+}
@@ -64,6 +64,7 @@ int main(){
   //R::MCTSAgent<R::Splitmix, R::GoBoard<SZ>, R::GoGameState<SZ>> agent(531441, 1., 1);
   //R::MCTSAgent<R::Splitmix, R::GoBoard<SZ>, R::GoGameState<SZ>> agent(531441, 1., 64);
   R::LPMCTSAgent<R::Splitmix, R::GoBoard<SZ>, R::GoGameState<SZ>> agent(531441, 1., 128);
+  //agent.set_budget(R::SearchBudget(531441, 5000, true)); //at most 5 seconds a move
   R::Player turn = R::Player::Black;
 
   while (not state.is_over()){
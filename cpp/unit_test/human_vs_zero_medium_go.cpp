@@ -101,8 +101,12 @@ int main(int argc, const char* argv[]){
     }
 
     state.apply_move(move);
+    //search on while the human thinks
+    if (turn == R::Player::White)
+      agent.start_pondering(state);
     turn = R::other_player(turn);
   }
+  agent.stop_pondering();
   s::cout << state.board() << s::endl;
 
   R::Player winner = state.winner();
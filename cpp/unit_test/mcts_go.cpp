@@ -10,6 +10,7 @@
 #include <splitmix.h>
 #include <agents/mcts_agent.h>
 #include <agents/lp_mcts_agent.h>
+#include <agents/tp_mcts_agent.h>
 
 namespace s = std;
 namespace c = s::chrono;
@@ -21,7 +22,9 @@ int main(){
   R::GoGameState<SZ> state;
   //R::MCTSAgent<R::Splitmix, R::GoBoard<SZ>, R::GoGameState<SZ>> agent(531441, 1., 1);
   //R::MCTSAgent<R::Splitmix, R::GoBoard<SZ>, R::GoGameState<SZ>> agent(531441, 1., 64);
+  //R::MCTSAgent<R::Splitmix, R::GoBoard<SZ>, R::GoGameState<SZ>> agent(531441, 1., 1, s::thread::hardware_concurrency());
   R::LPMCTSAgent<R::Splitmix, R::GoBoard<SZ>, R::GoGameState<SZ>> agent(531441, 1., 128);
+  //R::TPMCTSAgent<R::Splitmix, R::GoBoard<SZ>, R::GoGameState<SZ>> agent(531441, 1., 1);
   R::Player turn = R::Player::Black;
 
   while (not state.is_over()){
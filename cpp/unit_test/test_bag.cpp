@@ -115,3 +115,62 @@ TEST_F(TestBag, TestIterator1){
     EXPECT_TRUE(obj.test(counter++));
   }
 }
+
+struct TestFixedBag : ::testing::Test {
+  TestFixedBag(){}
+  ~TestFixedBag(){}
+
+  R::fixed_bag<bs, 32> b;
+};
+
+TEST_F(TestFixedBag, TestCopy1){
+  for (size_t i = 0; i < 3; ++i){
+    bs obj; obj.set(i);
+    b.push_back(obj);
+  }
+  R::fixed_bag<bs, 32> b2(b);
+  b.pop(0);
+  ASSERT_EQ(3, b2.size());
+  for (size_t i = 0; i < 3; ++i)
+    EXPECT_TRUE(b2[i].test(i));
+  b2 = b;
+  EXPECT_EQ(2, b2.size());
+  EXPECT_TRUE(b2[0].test(2));
+}
+
+TEST_F(TestFixedBag, TestSelfAssign1){
+  for (size_t i = 0; i < 3; ++i){
+    bs obj; obj.set(i);
+    b.push_back(obj);
+  }
+  R::fixed_bag<bs, 32>& alias = b;
+  b = alias;
+  ASSERT_EQ(3, b.size());
+  for (size_t i = 0; i < 3; ++i)
+    EXPECT_TRUE(b[i].test(i));
+}
+
+TEST_F(TestFixedBag, TestPush1){
+  for (size_t i = 0; i < 7; ++i){
+    bs obj; obj.set(i);
+    b.push_back(obj);
+  }
+  bs obj; obj.set(7);
+  b.push(3, obj);
+  ASSERT_EQ(8, b.size());
+  EXPECT_TRUE(b[3].test(7));
+  EXPECT_TRUE(b.back().test(3));
+}
+
+TEST_F(TestFixedBag, TestPop1){
+  for (size_t i = 0; i < 14; ++i){
+    bs obj; obj.set(i);
+    b.push_back(obj);
+  }
+  b.pop(10);
+  ASSERT_EQ(13, b.size());
+  for (size_t i = 0; i < b.size(); ++i)
+    EXPECT_FALSE(b[i].test(10) == true);
+  b.pop(b.size() - 1);
+  EXPECT_EQ(12, b.size());
+}
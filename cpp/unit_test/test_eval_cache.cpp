@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <vector>
+#include <thread>
+
+#include <type_alias.h>
+#include <eval_cache.h>
+
+namespace s = std;
+namespace R = rlgames;
+
+constexpr uint BF = 5;
+
+//priors that tell the evaluation of key apart
+s::array<float, BF> priors_of(uint64 key){
+  s::array<float, BF> ret;
+  for (uint i = 0; i < BF; ++i)
+    ret[i] = (float)(key % 97) + (float)i;
+  return ret;
+}
+
+struct TestEvalCache : ::testing::Test {
+  TestEvalCache(){}
+  ~TestEvalCache(){}
+};
+
+TEST_F(TestEvalCache, TestFind1){
+  R::EvalCache<BF> cache(16);
+  float value = 0.F;
+  s::array<float, BF> priors;
+  EXPECT_FALSE(cache.find(42, value, priors.data()));
+  cache.insert(42, 0.5F, priors_of(42).data());
+  EXPECT_TRUE(cache.find(42, value, priors.data()));
+  EXPECT_EQ(0.5F, value);
+  EXPECT_EQ(priors_of(42), priors);
+  EXPECT_EQ(1, cache.hits());
+  EXPECT_EQ(1, cache.misses());
+  EXPECT_FLOAT_EQ(0.5F, cache.hit_rate());
+}
+
+TEST_F(TestEvalCache, TestCapacity1){
+  R::EvalCache<BF> cache(10);
+  EXPECT_EQ(16, cache.capacity());
+  R::EvalCache<BF> one(1);
+  EXPECT_EQ(4, one.capacity());
+}
+
+TEST_F(TestEvalCache, TestEvict1){
+  //a single set of 4 entries, every key falls into it
+  R::EvalCache<BF> cache(1);
+  float value;
+  s::array<float, BF> priors;
+  for (uint64 i = 1; i <= 4; ++i)
+    cache.insert(i, (float)i, priors_of(i).data());
+  //1 and 3 are read and get a second chance
+  EXPECT_TRUE(cache.find(1, value, priors.data()));
+  EXPECT_TRUE(cache.find(3, value, priors.data()));
+  cache.insert(5, 5.F, priors_of(5).data());
+  EXPECT_FALSE(cache.find(2, value, priors.data()));
+  EXPECT_TRUE(cache.find(1, value, priors.data()));
+  EXPECT_TRUE(cache.find(3, value, priors.data()));
+  EXPECT_TRUE(cache.find(4, value, priors.data()));
+  EXPECT_TRUE(cache.find(5, value, priors.data()));
+  EXPECT_EQ(5.F, value);
+  EXPECT_EQ(priors_of(5), priors);
+}
+
+TEST_F(TestEvalCache, TestInsert1){
+  R::EvalCache<BF> cache(1);
+  float value;
+  s::array<float, BF> priors;
+  cache.insert(7, 0.25F, priors_of(7).data());
+  cache.insert(7, -0.25F, priors_of(8).data());
+  EXPECT_TRUE(cache.find(7, value, priors.data()));
+  EXPECT_EQ(0.25F, value);
+  EXPECT_EQ(priors_of(7), priors);
+}
+
+TEST_F(TestEvalCache, TestClear1){
+  R::EvalCache<BF> cache(16);
+  float value;
+  s::array<float, BF> priors;
+  cache.insert(3, 1.F, priors_of(3).data());
+  EXPECT_TRUE(cache.find(3, value, priors.data()));
+  cache.clear();
+  EXPECT_EQ(0, cache.hits());
+  EXPECT_EQ(0, cache.misses());
+  EXPECT_FALSE(cache.find(3, value, priors.data()));
+}
+
+TEST_F(TestEvalCache, TestThreads1){
+  R::EvalCache<BF> cache(1024);
+  s::vector<s::thread> threads;
+  for (uint t = 0; t < 4; ++t)
+    threads.emplace_back([&cache](){
+      float value;
+      s::array<float, BF> priors;
+      for (uint64 i = 0; i < 2000; ++i){
+        uint64 key = (i % 256) * 0x9E3779B97F4A7C15ULL;
+        if (cache.find(key, value, priors.data()))
+          EXPECT_EQ(priors_of(key), priors);
+        else
+          cache.insert(key, 1.F, priors_of(key).data());
+      }
+    });
+  for (s::thread& thread : threads)
+    thread.join();
+  EXPECT_EQ(8000, cache.hits() + cache.misses());
+  EXPECT_GT(cache.hit_rate(), 0.5F);
+}
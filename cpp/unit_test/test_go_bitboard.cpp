@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <type_alias.h>
+#include <types.h>
+#include <splitmix.h>
+#include <go_types.h>
+#include <go_bitboard.h>
+#include <zobrist_hash.h>
+
+namespace R = rlgames;
+namespace s = std;
+
+static constexpr ubyte Size = 9;
+static constexpr udyte ASize = 81;
+
+struct TestBitPlane : ::testing::Test {};
+
+template <ubyte SZ>
+void check_adjacent(){
+  for (uint i = 0; i < SZ * SZ; ++i){
+    R::BitPlane<SZ> b;
+    b.set(i);
+    R::BitPlane<SZ> adj = R::adjacent(b);
+    R::Pt pt = R::point<SZ>(i);
+    uint expected = 0;
+    for (R::Pt n : R::neighbours(pt))
+      if (n.r < SZ && n.c < SZ){
+        expected++;
+        ASSERT_TRUE(adj.test(R::index<SZ>(n)));
+      }
+    ASSERT_EQ(expected, adj.count());
+  }
+}
+
+TEST_F(TestBitPlane, TestAdjacent1){
+  check_adjacent<5>();
+  check_adjacent<9>();
+  check_adjacent<13>();
+  check_adjacent<19>();
+}
+
+TEST_F(TestBitPlane, TestFloodFill1){
+  R::BitPlane<19> region;
+  for (uint c = 0; c < 19; ++c) region.set(R::index<19>(R::Pt(10, c)));
+  region.set(R::index<19>(R::Pt(0, 0)));
+  R::BitPlane<19> seed;
+  seed.set(R::index<19>(R::Pt(10, 18)));
+  R::BitPlane<19> filled = R::flood_fill(seed, region);
+
+  EXPECT_EQ(19, filled.count());
+  EXPECT_FALSE(filled.test(R::index<19>(R::Pt(0, 0))));
+  EXPECT_EQ(R::index<19>(R::Pt(10, 0)), filled.first());
+}
+
+struct TestGoBitBoard : ::testing::Test {
+  TestGoBitBoard(){}
+  ~TestGoBitBoard(){}
+
+  R::GoBitBoard<Size> board;
+};
+
+TEST_F(TestGoBitBoard, TestGet1){
+  EXPECT_EQ(R::Player::Unknown, board.get(R::Pt(3, 3)));
+  EXPECT_FALSE(board.get_string(R::Pt(3, 3)));
+}
+
+TEST_F(TestGoBitBoard, TestHash1){
+  EXPECT_EQ(R::EMPTY_BOARD, board.hash());
+}
+
+TEST_F(TestGoBitBoard, TestPlaceStone1){
+  board.place_stone(R::Player::Black, R::Pt(2, 2));
+  EXPECT_EQ(R::Player::Black, board.get(R::Pt(2, 2)));
+  ASSERT_TRUE(board.get_string(R::Pt(2, 2)));
+  EXPECT_EQ(4, board.get_string(R::Pt(2, 2))->num_liberties());
+  EXPECT_EQ(1, board.get_string(R::Pt(2, 2))->size());
+}
+
+TEST_F(TestGoBitBoard, TestPlaceStone2){
+  board.place_stone(R::Player::Black, R::Pt(0, 4));
+  board.place_stone(R::Player::Black, R::Pt(0, 6));
+  board.place_stone(R::Player::Black, R::Pt(1, 5));
+  board.place_stone(R::Player::Black, R::Pt(0, 5));
+
+  EXPECT_EQ(4, board.get_string(R::Pt(0, 5))->size());
+  EXPECT_EQ(5, board.get_string(R::Pt(0, 5))->num_liberties());
+}
+
+TEST_F(TestGoBitBoard, TestPlaceStone3){
+  board.place_stone(R::Player::White, R::Pt(0, 0));
+  board.place_stone(R::Player::White, R::Pt(0, 1));
+  board.place_stone(R::Player::White, R::Pt(1, 0));
+  board.place_stone(R::Player::Black, R::Pt(0, 2));
+  board.place_stone(R::Player::Black, R::Pt(1, 1));
+  board.place_stone(R::Player::Black, R::Pt(2, 0));
+
+  EXPECT_EQ(R::Player::Unknown, board.get(R::Pt(0, 0)));
+  EXPECT_EQ(R::Player::Unknown, board.get(R::Pt(0, 1)));
+  EXPECT_EQ(R::Player::Unknown, board.get(R::Pt(1, 0)));
+  EXPECT_EQ(4, board.get_string(R::Pt(1, 1))->num_liberties());
+
+  R::GoBitBoard<Size> expected;
+  expected.place_stone(R::Player::Black, R::Pt(0, 2));
+  expected.place_stone(R::Player::Black, R::Pt(1, 1));
+  expected.place_stone(R::Player::Black, R::Pt(2, 0));
+  EXPECT_EQ(expected.hash(), board.hash());
+}
+
+// the bit board must agree with the bag board on every observable property
+template <ubyte SZ>
+void check_agrees_with_go_board(uint seed, uint games){
+  R::Splitmix gen(seed);
+  for (uint game = 0; game < games; ++game){
+    R::GoGameState<SZ> reference;
+    R::GoBitGameState<SZ> state;
+    for (uint step = 0; step < SZ * SZ * 3 && not reference.is_over(); ++step){
+      s::vector<R::Move> moves = reference.legal_moves();
+      ASSERT_EQ(moves.size(), state.legal_moves().size());
+      ASSERT_EQ(reference.legal_moves_mask(), state.legal_moves_mask());
+
+      //avoid resigning to keep the games long
+      R::Move move = moves[gen() % (moves.size() - 1)];
+      reference.apply_move(move);
+      state.apply_move(move);
+
+      ASSERT_EQ(reference.board().hash(), state.board().hash());
+      R::GoAreaScore<SZ> reference_scorer(reference.board());
+      R::GoAreaScore<SZ, R::GoBitBoard<SZ>> scorer(state.board());
+      ASSERT_EQ(reference_scorer.winning_margin(), scorer.winning_margin());
+      for (uint i = 0; i < SZ * SZ; ++i){
+        R::Pt pt = R::point<SZ>(i);
+        ASSERT_EQ(reference.board().get(pt), state.board().get(pt));
+        if (reference.board().get(pt) != R::Player::Unknown){
+          ASSERT_EQ(reference.board().get_string(pt)->num_liberties(), state.board().get_string(pt)->num_liberties());
+        }
+      }
+    }
+  }
+}
+
+TEST_F(TestGoBitBoard, TestAgreesWithGoBoard1){
+  check_agrees_with_go_board<Size>(1234, 20);
+}
+
+TEST_F(TestGoBitBoard, TestAgreesWithGoBoard2){
+  check_agrees_with_go_board<19>(5678, 2);
+}
+
+TEST_F(TestGoBitBoard, TestUndo1){
+  R::Splitmix gen(99);
+  R::GoBitGameState<Size> state;
+  s::vector<R::GoBitGameState<Size>> states;
+  s::vector<R::GoBitGameState<Size>::Undo> undos(200);
+  for (uint step = 0; step < 200 && not state.is_over(); ++step){
+    states.push_back(state);
+    s::vector<R::Move> moves = state.legal_moves();
+    state.apply_move(moves[gen() % (moves.size() - 1)], undos[step]);
+  }
+  while (states.size() > 0){
+    state.undo_move(undos[states.size() - 1]);
+    const R::GoBitGameState<Size>& expected = states.back();
+    ASSERT_EQ(expected.board().hash(), state.board().hash());
+    ASSERT_EQ(expected.next_player(), state.next_player());
+    ASSERT_TRUE(expected.board().stones(R::Player::Black) == state.board().stones(R::Player::Black));
+    ASSERT_TRUE(expected.board().stones(R::Player::White) == state.board().stones(R::Player::White));
+    ASSERT_EQ(expected.legal_moves().size(), state.legal_moves().size());
+    states.pop_back();
+  }
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <type_alias.h>
+#include <types.h>
+#include <splitmix.h>
+#include <go_types.h>
+#include <go_chain_board.h>
+#include <zobrist_hash.h>
+
+namespace R = rlgames;
+namespace s = std;
+
+static constexpr ubyte Size = 9;
+static constexpr udyte ASize = 81;
+
+struct MockGoChainBoard : public R::GoChainBoard<Size> {
+  using R::GoChainBoard<Size>::get_head;
+};
+
+struct TestGoChainBoard : ::testing::Test {
+  TestGoChainBoard(){}
+  ~TestGoChainBoard(){}
+
+  MockGoChainBoard board;
+};
+
+TEST_F(TestGoChainBoard, TestGet1){
+  EXPECT_EQ(R::Player::Unknown, board.get(R::Pt(3, 3)));
+}
+
+TEST_F(TestGoChainBoard, TestHash1){
+  EXPECT_EQ(R::EMPTY_BOARD, board.hash());
+}
+
+TEST_F(TestGoChainBoard, TestPlaceStone1){
+  board.place_stone(R::Player::Black, R::Pt(2, 2));
+  EXPECT_EQ(R::Player::Black, board.get(R::Pt(2, 2)));
+  ASSERT_TRUE(board.get_string(R::Pt(2, 2)) != nullptr);
+  EXPECT_EQ(4, board.get_string(R::Pt(2, 2))->num_liberties());
+  EXPECT_EQ(1, board.get_string(R::Pt(2, 2))->size());
+}
+
+TEST_F(TestGoChainBoard, TestPlaceStone2){
+  board.place_stone(R::Player::Black, R::Pt(0, 4));
+  board.place_stone(R::Player::Black, R::Pt(0, 6));
+  board.place_stone(R::Player::Black, R::Pt(1, 5));
+  board.place_stone(R::Player::Black, R::Pt(0, 5));
+
+  udyte head = board.get_head(R::Pt(0, 5));
+  EXPECT_EQ(head, board.get_head(R::Pt(0, 4)));
+  EXPECT_EQ(head, board.get_head(R::Pt(0, 6)));
+  EXPECT_EQ(head, board.get_head(R::Pt(1, 5)));
+  EXPECT_EQ(4, board.get_string(R::Pt(0, 5))->size());
+  EXPECT_EQ(5, board.get_string(R::Pt(0, 5))->num_liberties());
+}
+
+TEST_F(TestGoChainBoard, TestPlaceStone3){
+  board.place_stone(R::Player::Black, R::Pt(2, 3));
+  board.place_stone(R::Player::White, R::Pt(2, 4));
+  board.place_stone(R::Player::Black, R::Pt(3, 2));
+  board.place_stone(R::Player::White, R::Pt(3, 3));
+  board.place_stone(R::Player::Black, R::Pt(4, 3));
+  board.place_stone(R::Player::White, R::Pt(4, 4));
+  board.place_stone(R::Player::Black, R::Pt(3, 4));
+
+  EXPECT_EQ(R::Player::Unknown, board.get(R::Pt(3, 3)));
+  EXPECT_EQ(4, board.get_string(R::Pt(3, 2))->num_liberties());
+  EXPECT_EQ(3, board.get_string(R::Pt(2, 3))->num_liberties());
+  EXPECT_EQ(2, board.get_string(R::Pt(3, 4))->num_liberties());
+}
+
+TEST_F(TestGoChainBoard, TestPlaceStone4){
+  board.place_stone(R::Player::White, R::Pt(0, 0));
+  board.place_stone(R::Player::White, R::Pt(0, 1));
+  board.place_stone(R::Player::White, R::Pt(1, 0));
+  board.place_stone(R::Player::Black, R::Pt(0, 2));
+  board.place_stone(R::Player::Black, R::Pt(1, 1));
+  board.place_stone(R::Player::Black, R::Pt(2, 0));
+
+  EXPECT_EQ(R::Player::Unknown, board.get(R::Pt(0, 0)));
+  EXPECT_EQ(R::Player::Unknown, board.get(R::Pt(0, 1)));
+  EXPECT_EQ(R::Player::Unknown, board.get(R::Pt(1, 0)));
+  EXPECT_EQ(4, board.get_string(R::Pt(1, 1))->num_liberties());
+
+  R::GoChainBoard<Size> expected;
+  expected.place_stone(R::Player::Black, R::Pt(0, 2));
+  expected.place_stone(R::Player::Black, R::Pt(1, 1));
+  expected.place_stone(R::Player::Black, R::Pt(2, 0));
+  EXPECT_EQ(expected.hash(), board.hash());
+}
+
+// the chain board must agree with the bag board on every observable property
+TEST_F(TestGoChainBoard, TestAgreesWithGoBoard1){
+  R::Splitmix gen(1234);
+  for (uint game = 0; game < 20; ++game){
+    R::GoGameState<Size> reference;
+    R::GoChainGameState<Size> state;
+    for (uint step = 0; step < 300 && not reference.is_over(); ++step){
+      s::vector<R::Move> moves = reference.legal_moves();
+      s::vector<R::Move> chain_moves = state.legal_moves();
+      ASSERT_EQ(moves.size(), chain_moves.size());
+
+      //avoid resigning to keep the games long
+      R::Move move = moves[gen() % (moves.size() - 1)];
+      reference.apply_move(move);
+      state.apply_move(move);
+
+      ASSERT_EQ(reference.board().hash(), state.board().hash());
+      for (uint i = 0; i < ASize; ++i){
+        R::Pt pt = R::point<Size>(i);
+        ASSERT_EQ(reference.board().get(pt), state.board().get(pt));
+        if (reference.board().get(pt) != R::Player::Unknown){
+          ASSERT_EQ(reference.board().get_string(pt)->num_liberties(), state.board().get_string(pt)->num_liberties());
+        }
+      }
+    }
+  }
+}
+
+TEST_F(TestGoChainBoard, TestUndo1){
+  R::Splitmix gen(99);
+  R::GoChainGameState<Size> state;
+  s::vector<R::GoChainGameState<Size>> states;
+  s::vector<R::GoChainGameState<Size>::Undo> undos(200);
+  for (uint step = 0; step < 200 && not state.is_over(); ++step){
+    states.push_back(state);
+    s::vector<R::Move> moves = state.legal_moves();
+    state.apply_move(moves[gen() % (moves.size() - 1)], undos[step]);
+  }
+  while (states.size() > 0){
+    state.undo_move(undos[states.size() - 1]);
+    const R::GoChainGameState<Size>& expected = states.back();
+    ASSERT_EQ(expected.board().hash(), state.board().hash());
+    ASSERT_EQ(expected.next_player(), state.next_player());
+    for (uint i = 0; i < ASize; ++i){
+      R::Pt pt = R::point<Size>(i);
+      ASSERT_EQ(expected.board().get(pt), state.board().get(pt));
+      if (expected.board().get(pt) != R::Player::Unknown){
+        ASSERT_EQ(expected.board().get_string(pt)->num_liberties(), state.board().get_string(pt)->num_liberties());
+        ASSERT_EQ(expected.board().get_string(pt)->size(), state.board().get_string(pt)->size());
+      }
+    }
+    ASSERT_EQ(expected.legal_moves().size(), state.legal_moves().size());
+    states.pop_back();
+  }
+}
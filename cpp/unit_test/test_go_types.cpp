@@ -2,7 +2,9 @@
 
 #include <type_alias.h>
 #include <types.h>
+#include <splitmix.h>
 #include <go_types.h>
+#include <agents/agent_base.h>
 #include <zobrist_hash.h>
 
 namespace R = rlgames;
@@ -264,7 +266,7 @@ TEST_F(TestGoBoard, TestPlaceStone1){
   board.place_stone(R::Player::Black, R::Pt(1, 1));
   EXPECT_EQ(R::Player::Black, board.get(R::Pt(1, 1)));
 
-  uint expected = R::zobrist_hash<Size>(R::Player::Black, R::Pt(1, 1));
+  uint64 expected = R::zobrist_hash<Size>(R::Player::Black, R::Pt(1, 1));
 
   EXPECT_EQ(expected, board.hash());
   EXPECT_TRUE(board.get_string(R::Pt(1, 1)) != nullptr);
@@ -278,7 +280,7 @@ TEST_F(TestGoBoard, TestPlaceStone2){
   board.place_stone(R::Player::White, R::Pt(7, 8));
   EXPECT_EQ(R::Player::White, board.get(R::Pt(7, 8)));
 
-  uint expected = R::zobrist_hash<Size>(R::Player::White, R::Pt(7, 8));
+  uint64 expected = R::zobrist_hash<Size>(R::Player::White, R::Pt(7, 8));
 
   EXPECT_EQ(expected, board.hash());
   EXPECT_TRUE(board.get_string(R::Pt(7, 8)) != nullptr);
@@ -457,9 +459,53 @@ TEST_F(TestGoBoard, TestRemoveString1){
   EXPECT_TRUE(board.get_string(R::Pt(3, 4)) != nullptr);
 }
 
+TEST(TestGoHistory, TestInsert1){
+  R::GoHistory<Size> history;
+  EXPECT_FALSE(history.contains(0x1234ULL));
+  EXPECT_TRUE(history.insert(0x1234ULL));
+  EXPECT_FALSE(history.insert(0x1234ULL));
+  EXPECT_TRUE(history.contains(0x1234ULL));
+  EXPECT_EQ(1U, history.size());
+}
+
+TEST(TestGoHistory, TestShared1){
+  R::GoHistory<Size> history;
+  for (uint64 i = 1; i <= 100; ++i)
+    history.insert(i * 0x9E3779B97F4A7C15ULL);
+  R::GoHistory<Size> copy = history;
+  copy.insert(0xABCDULL);
+
+  EXPECT_TRUE(copy.contains(0xABCDULL));
+  EXPECT_FALSE(history.contains(0xABCDULL));
+  for (uint64 i = 1; i <= 100; ++i)
+    ASSERT_TRUE(copy.contains(i * 0x9E3779B97F4A7C15ULL));
+  EXPECT_TRUE(history != copy);
+
+  copy.pop();
+  EXPECT_FALSE(copy.contains(0xABCDULL));
+  EXPECT_TRUE(history == copy);
+}
+
+TEST(TestGoHistory, TestPop1){
+  R::GoHistory<Size> history;
+  history.insert(0x1234ULL);
+  ubyte added;
+  EXPECT_TRUE(history.insert(0x5678ULL << 32 | 0x9ABCULL, added));
+  EXPECT_EQ(3U, added);
+  history.pop(added);
+  EXPECT_FALSE(history.contains(0x5678ULL << 32 | 0x9ABCULL));
+  EXPECT_EQ(1U, history.size());
+
+  //a probe already set by another hash stays set
+  EXPECT_TRUE(history.insert(0x77ULL << 32 | 0x1234ULL, added));
+  EXPECT_EQ(2U, added);
+  history.pop(added);
+  EXPECT_TRUE(history.contains(0x1234ULL));
+}
+
 struct MockGoGameState : public R::GoGameState<Size> {
   MockGoGameState(): GoGameState(){}
-  MockGoGameState(const R::GoBoard<Size>& board, R::Player player, R::Move pm, R::Move ppm, const s::unordered_set<uint>& history):
+  MockGoGameState(const R::GoBoard<Size>& board, R::Player player, R::Move pm, R::Move ppm, const R::GoHistory<Size>& history):
     GoGameState(board, player, pm, ppm, history){}
   MockGoGameState(const MockGoGameState& o): GoGameState(static_cast<const GoGameState&>(o)){}
   MockGoGameState& operator=(const MockGoGameState& o){
@@ -469,6 +515,7 @@ struct MockGoGameState : public R::GoGameState<Size> {
 
   using GoGameState::is_move_self_capture;
   using GoGameState::does_move_violate_ko;
+  using GoGameState::mHistory;
 };
 
 struct TestGoGameState : ::testing::Test {
@@ -512,6 +559,23 @@ TEST_F(TestGoGameState, TestDoesMoveViolateKo1){
   EXPECT_TRUE(state.does_move_violate_ko(R::Move(R::M::Play, R::Pt(3, 4))));
 }
 
+//neighbour inspection must agree with playing the move on a trial board
+TEST_F(TestGoGameState, TestIsMoveSelfCapture2){
+  R::Splitmix gen(2468);
+  for (uint step = 0; step < 300 && not state.is_over(); ++step){
+    for (uint i = 0; i < ASize; ++i){
+      R::Pt pt = R::point<Size>(i);
+      if (state.board().get(pt) != R::Player::Unknown) continue;
+      R::GoBoard<Size> trial = state.board();
+      trial.place_stone(state.next_player(), pt);
+      ASSERT_EQ(trial.get_string(pt)->num_liberties() == 0, state.is_move_self_capture(R::Move(R::M::Play, pt)));
+      ASSERT_EQ(trial.hash(), state.board().hash_after_move(state.next_player(), pt));
+    }
+    s::vector<R::Move> moves = state.legal_moves();
+    state.apply_move(moves[gen() % (moves.size() - 1)]);
+  }
+}
+
 TEST_F(TestGoGameState, TestValidMove1){
   state.apply_move(R::Move(R::M::Resign));
 
@@ -565,12 +629,125 @@ TEST_F(TestGoGameState, TestLegalMoves3){
   EXPECT_EQ(ASize - 6, ret.size());
 }
 
+TEST_F(TestGoGameState, TestLegalMovesMask1){
+  R::Splitmix gen(2468);
+  for (uint step = 0; step < 200 && not state.is_over(); ++step){
+    s::vector<R::Move> moves = state.legal_moves();
+    MockGoGameState::MoveMask mask = state.legal_moves_mask();
+    ASSERT_EQ(moves.size() - 1, mask.count());
+    for (const R::Move& m : moves){
+      if (m.mty == R::M::Play){
+        ASSERT_TRUE(mask.test(R::index<Size>(m.mpt)));
+      }
+    }
+    ASSERT_TRUE(mask.test(ASize));
+    state.apply_move(moves[gen() % (moves.size() - 1)]);
+  }
+}
+
+//padded eye test must agree with the bound checked one shared by all layouts
+TEST_F(TestGoGameState, TestIsPointAnEye1){
+  R::Splitmix gen(1357);
+  R::IsPointAnEye<R::GoBoard<Size>> is_point_an_eye;
+  R::IsPointAGoEye<R::GoBoard<Size>> is_point_a_go_eye;
+  uint eyes = 0;
+  for (uint step = 0; step < 200 && not state.is_over(); ++step){
+    for (uint i = 0; i < ASize; ++i)
+      for (R::Player player : {R::Player::Black, R::Player::White}){
+        bool eye = is_point_an_eye(state.board(), R::point<Size>(i), player);
+        ASSERT_EQ(is_point_a_go_eye(state.board(), R::point<Size>(i), player), eye);
+        eyes += eye;
+      }
+    s::vector<R::Move> moves = state.legal_moves();
+    state.apply_move(moves[gen() % (moves.size() - 1)]);
+  }
+  EXPECT_LT(0U, eyes);
+}
+
+TEST_F(TestGoGameState, TestKey1){
+  EXPECT_EQ(R::EMPTY_BOARD, state.key());
+  state.apply_move(R::Move(R::M::Play, R::Pt(4, 4)));
+  EXPECT_EQ(state.board().hash() ^ R::ZOBRIST_WHITE_TO_MOVE_KEY, state.key());
+  EXPECT_FALSE(state.ko_point());
+}
+
+TEST_F(TestGoGameState, TestKey2){
+  state.apply_move(R::Move(R::M::Play, R::Pt(0, 1)));
+  state.apply_move(R::Move(R::M::Play, R::Pt(0, 2)));
+  state.apply_move(R::Move(R::M::Play, R::Pt(1, 0)));
+  state.apply_move(R::Move(R::M::Play, R::Pt(2, 2)));
+  state.apply_move(R::Move(R::M::Play, R::Pt(2, 1)));
+  state.apply_move(R::Move(R::M::Play, R::Pt(1, 3)));
+  state.apply_move(R::Move(R::M::Play, R::Pt(1, 2)));
+  EXPECT_FALSE(state.ko_point());
+  state.apply_move(R::Move(R::M::Play, R::Pt(1, 1)));
+
+  ASSERT_TRUE(state.ko_point());
+  EXPECT_TRUE(R::Pt(1, 2) == *state.ko_point());
+  EXPECT_EQ(state.board().hash() ^ R::zobrist_ko_hash<Size>(R::Pt(1, 2)), state.key());
+
+  //ko is gone once black plays elsewhere
+  state.apply_move(R::Move(R::M::Play, R::Pt(6, 6)));
+  EXPECT_FALSE(state.ko_point());
+}
+
 TEST_F(TestGoGameState, TestWinner1){
   state.apply_move(R::Move(R::M::Resign));
 
   EXPECT_EQ(R::Player::White, state.winner());
 }
 
+TEST_F(TestGoGameState, TestUndoMove1){
+  state.apply_move(R::Move(R::M::Play, R::Pt(2, 3)));
+  state.apply_move(R::Move(R::M::Play, R::Pt(2, 4)));
+  state.apply_move(R::Move(R::M::Play, R::Pt(3, 2)));
+  state.apply_move(R::Move(R::M::Play, R::Pt(3, 3)));
+  state.apply_move(R::Move(R::M::Play, R::Pt(4, 3)));
+  state.apply_move(R::Move(R::M::Play, R::Pt(4, 4)));
+  MockGoGameState before = state;
+
+  MockGoGameState::Undo undo;
+  state.apply_move(R::Move(R::M::Play, R::Pt(3, 4)), undo);
+  EXPECT_EQ(R::Player::Unknown, state.board().get(R::Pt(3, 3)));
+  state.undo_move(undo);
+
+  EXPECT_EQ(R::Player::White, state.board().get(R::Pt(3, 3)));
+  EXPECT_EQ(R::Player::Unknown, state.board().get(R::Pt(3, 4)));
+  EXPECT_EQ(before.board().hash(), state.board().hash());
+  EXPECT_EQ(before.mHistory, state.mHistory);
+  EXPECT_EQ(R::Player::Black, state.next_player());
+}
+
+//walk down a random game with undo records, then back up comparing against
+//copies taken on the way down
+TEST_F(TestGoGameState, TestUndoMove2){
+  R::Splitmix gen(4321);
+  s::vector<MockGoGameState> states;
+  s::vector<MockGoGameState::Undo> undos(200);
+  for (uint step = 0; step < 200 && not state.is_over(); ++step){
+    states.push_back(state);
+    s::vector<R::Move> moves = state.legal_moves();
+    state.apply_move(moves[gen() % (moves.size() - 1)], undos[step]);
+  }
+  while (states.size() > 0){
+    state.undo_move(undos[states.size() - 1]);
+    const MockGoGameState& expected = states.back();
+    ASSERT_EQ(expected.board().hash(), state.board().hash());
+    ASSERT_EQ(expected.next_player(), state.next_player());
+    ASSERT_TRUE(expected.previous_move() == state.previous_move());
+    ASSERT_EQ(expected.mHistory, state.mHistory);
+    for (uint i = 0; i < ASize; ++i){
+      R::Pt pt = R::point<Size>(i);
+      ASSERT_EQ(expected.board().get(pt), state.board().get(pt));
+      if (expected.board().get(pt) != R::Player::Unknown){
+        ASSERT_TRUE(*expected.board().get_string(pt) == *state.board().get_string(pt));
+      }
+    }
+    ASSERT_EQ(expected.legal_moves().size(), state.legal_moves().size());
+    states.pop_back();
+  }
+}
+
 struct MockGoAreaScore : public R::GoAreaScore<Size> {
   MockGoAreaScore(MockGoBoard& board, float komi = 7.5):
     R::GoAreaScore<Size>(static_cast<R::GoBoard<Size>&>(board), komi) {}
@@ -695,5 +872,15 @@ TEST_F(TestGoAreaScore, TestWinningMargin1){
   EXPECT_EQ(-14.5, scorer.winning_margin());
 }
 
+TEST_F(TestGoAreaScore, TestWinningMargins1){
+  s::vector<R::GoBoard<Size>> boards{board, R::GoBoard<Size>(), board};
+  s::vector<float> margins(boards.size());
+  R::GoAreaScore<Size>::winning_margins(boards.begin(), boards.end(), margins.begin(), 7.5);
+
+  EXPECT_EQ(-14.5, margins[0]);
+  EXPECT_EQ(-7.5, margins[1]);
+  EXPECT_EQ(-14.5, margins[2]);
+}
+
 //TODO: test zobrist hash being correct after string removal
 //TODO: test board.place_stone() more thoroughly
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include <type_alias.h>
+#include <types.h>
+#include <go_types.h>
+#include <splitmix.h>
+#include <node_pool.h>
+#include <agents/mcts_agent.h>
+#include <agents/lp_mcts_agent.h>
+#include <agents/tp_mcts_agent.h>
+
+namespace s = std;
+namespace R = rlgames;
+
+constexpr ubyte SZ = 9;
+
+using Board = R::GoBoard<SZ>;
+using GameState = R::GoGameState<SZ>;
+
+//the root has two live children, the first with 100 playouts and the better
+//mean, the second with 2. with a large exploration factor uct must descend
+//into the less visited child for either player to move
+struct TestMCTSSelect : ::testing::Test {
+  static constexpr float EFACTOR = 2.F;
+
+  TestMCTSSelect(){}
+  ~TestMCTSSelect(){}
+
+  //mean score of a child from black's view, better for the player to move
+  //on the first child
+  float mean(const GameState& gs, uint child){
+    float sign = gs.next_player() == R::Player::Black ? 1.F : -1.F;
+    return sign * (child == 0 ? 2.F : 1.F);
+  }
+  size_t count(uint child){
+    return child == 0 ? 100U : 2U;
+  }
+};
+
+template <typename Agent>
+struct SelectProbe : Agent {
+  using MCTSNode = typename Agent::MCTSNode;
+
+  template <typename... Args>
+  explicit SelectProbe(Args&&... args): Agent(s::forward<Args>(args)...) {}
+
+  //root with its first two edges expanded, the rest exhausted
+  MCTSNode* make_root(TestMCTSSelect& t, const GameState& gs, R::node_pool<MCTSNode>& arena){
+    MCTSNode* root = arena.construct(gs, nullptr, 0U);
+    root->nexpanded = root->edges.size();
+    for (uint i = 0; i < root->edges.size(); ++i){
+      if (i >= 2){
+        root->edges[i].exhausted = true;
+        continue;
+      }
+      GameState child_state = gs;
+      child_state.apply_move(root->edges[i].move());
+      root->edges[i].child = arena.construct(child_state, root, i);
+      root->edges[i].ncount = t.count(i);
+      root->edges[i].qvalue = t.mean(gs, i) * t.count(i);
+    }
+    root->ncount = t.count(0) + t.count(1);
+    return root;
+  }
+};
+
+struct MCTSProbe : SelectProbe<R::MCTSAgent<R::Splitmix, Board, GameState>> {
+  MCTSProbe(): SelectProbe(100, TestMCTSSelect::EFACTOR) {}
+
+  bool descends_second(TestMCTSSelect& t, const GameState& gs){
+    R::node_pool<MCTSNode> arena(8);
+    MCTSNode* root = make_root(t, gs, arena);
+    GameState state = gs;
+    R::Splitmix gen(1);
+    R::UndoStack<GameState> undo;
+    MCTSNode* leaf = recursive_uct(root, state, undo, arena, gen);
+    return leaf->parent == root->edges[1].child;
+  }
+};
+
+struct LPMCTSProbe : SelectProbe<R::LPMCTSAgent<R::Splitmix, Board, GameState>> {
+  LPMCTSProbe(): SelectProbe(100, TestMCTSSelect::EFACTOR, 1, 1) {}
+
+  bool descends_second(TestMCTSSelect& t, const GameState& gs){
+    R::node_pool<MCTSNode> arena(8);
+    MCTSNode* root = make_root(t, gs, arena);
+    GameState state = gs;
+    R::UndoStack<GameState> undo;
+    MCTSNode* leaf = recursive_uct(root, state, undo, arena);
+    return leaf->parent == root->edges[1].child;
+  }
+};
+
+struct TPMCTSProbe : R::TPMCTSAgent<R::Splitmix, Board, GameState> {
+  TPMCTSProbe(): TPMCTSAgent(100, TestMCTSSelect::EFACTOR, 1, 1) {}
+
+  bool descends_second(TestMCTSSelect& t, const GameState& gs){
+    mPool.reset();
+    mPool.reserve(8);
+    MCTSNode* root = mPool.construct(gs, nullptr, 0U);
+    root->nclaimed = root->nedges;
+    MCTSNode* children[2];
+    for (uint i = 0; i < 2; ++i){
+      GameState child_state = gs;
+      child_state.apply_move(root->edges[i].move());
+      children[i] = mPool.construct(child_state, root, 0U);
+      children[i]->ncount = t.count(i);
+      children[i]->qvalue = t.mean(gs, i) * t.count(i);
+      root->edges[i].child = children[i];
+    }
+    root->ncount = t.count(0) + t.count(1);
+    GameState state = gs;
+    R::Splitmix gen(1);
+    R::UndoStack<GameState> undo;
+    MCTSNode* leaf = select(root, state, undo, gen);
+    return leaf->parent == children[1];
+  }
+};
+
+GameState white_to_move(){
+  GameState gs;
+  gs.apply_move(R::Move(R::M::Play, R::Pt(4, 4)));
+  return gs;
+}
+
+TEST_F(TestMCTSSelect, TestMCTSBlack){
+  MCTSProbe agent;
+  EXPECT_TRUE(agent.descends_second(*this, GameState()));
+}
+
+TEST_F(TestMCTSSelect, TestMCTSWhite){
+  MCTSProbe agent;
+  EXPECT_TRUE(agent.descends_second(*this, white_to_move()));
+}
+
+TEST_F(TestMCTSSelect, TestLPMCTSBlack){
+  LPMCTSProbe agent;
+  EXPECT_TRUE(agent.descends_second(*this, GameState()));
+}
+
+TEST_F(TestMCTSSelect, TestLPMCTSWhite){
+  LPMCTSProbe agent;
+  EXPECT_TRUE(agent.descends_second(*this, white_to_move()));
+}
+
+TEST_F(TestMCTSSelect, TestTPMCTSBlack){
+  TPMCTSProbe agent;
+  EXPECT_TRUE(agent.descends_second(*this, GameState()));
+}
+
+TEST_F(TestMCTSSelect, TestTPMCTSWhite){
+  TPMCTSProbe agent;
+  EXPECT_TRUE(agent.descends_second(*this, white_to_move()));
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+#include <thread>
+#include <atomic>
+
+#include <type_alias.h>
+#include <mpmc_queue.h>
+
+namespace s = std;
+namespace R = rlgames;
+
+struct TestMPMCQueue : ::testing::Test {
+  TestMPMCQueue(){}
+  ~TestMPMCQueue(){}
+};
+
+TEST_F(TestMPMCQueue, TestCapacity1){
+  R::mpmc_queue<uint> q(5);
+  EXPECT_EQ(8, q.capacity());
+  R::mpmc_queue<uint> one(1);
+  EXPECT_EQ(1, one.capacity());
+}
+
+TEST_F(TestMPMCQueue, TestPushPop1){
+  R::mpmc_queue<uint> q(4);
+  uint v = 0;
+  EXPECT_FALSE(q.try_pop(v));
+  for (uint i = 1; i <= 4; ++i)
+    EXPECT_TRUE(q.try_push(uint(i)));
+  EXPECT_FALSE(q.try_push(5U));
+  EXPECT_EQ(4, q.size_approx());
+  for (uint i = 1; i <= 4; ++i){
+    EXPECT_TRUE(q.try_pop(v));
+    EXPECT_EQ(i, v);
+  }
+  EXPECT_FALSE(q.try_pop(v));
+  EXPECT_EQ(0, q.size_approx());
+}
+
+TEST_F(TestMPMCQueue, TestWrapAround1){
+  R::mpmc_queue<uint> q(2);
+  uint v = 0;
+  for (uint i = 0; i < 10; ++i){
+    EXPECT_TRUE(q.try_push(uint(i)));
+    EXPECT_TRUE(q.try_pop(v));
+    EXPECT_EQ(i, v);
+  }
+}
+
+TEST_F(TestMPMCQueue, TestMoveOnly1){
+  R::mpmc_queue<s::unique_ptr<uint>> q(2);
+  s::unique_ptr<uint> a(new uint(3));
+  EXPECT_TRUE(q.try_push(s::move(a)));
+  s::unique_ptr<uint> b;
+  EXPECT_TRUE(q.try_pop(b));
+  EXPECT_EQ(3U, *b);
+}
+
+TEST_F(TestMPMCQueue, TestThreads1){
+  constexpr uint PRODUCERS = 4, CONSUMERS = 4, COUNT = 20000;
+  R::mpmc_queue<uint> q(64);
+  s::atomic<uint64> sum(0);
+  s::atomic<uint> popped(0);
+  s::vector<s::thread> threads;
+  for (uint p = 0; p < PRODUCERS; ++p)
+    threads.emplace_back([&q](){
+      for (uint i = 1; i <= COUNT; ++i)
+        while (not q.try_push(uint(i)))
+          s::this_thread::yield();
+    });
+  for (uint c = 0; c < CONSUMERS; ++c)
+    threads.emplace_back([&](){
+      uint v;
+      while (popped.load() < PRODUCERS * COUNT){
+        if (q.try_pop(v)){
+          sum.fetch_add(v);
+          popped.fetch_add(1);
+        } else
+          s::this_thread::yield();
+      }
+    });
+  for (s::thread& thread : threads)
+    thread.join();
+  EXPECT_EQ((uint64)PRODUCERS * COUNT * (COUNT + 1) / 2, sum.load());
+  EXPECT_EQ(0, q.size_approx());
+}
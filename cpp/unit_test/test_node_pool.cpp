@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <set>
+#include <atomic>
+#include <thread>
+
+#include <type_alias.h>
+#include <node_pool.h>
+
+namespace s = std;
+namespace R = rlgames;
+
+//counts live objects to check construction and destruction
+struct Counted {
+  static int live;
+  s::vector<uint> payload;
+  Counted* link;
+
+  explicit Counted(uint v, Counted* link = nullptr): payload(3, v), link(link) { live++; }
+  Counted(Counted&& o): payload(s::move(o.payload)), link(o.link) { live++; }
+  ~Counted(){ live--; }
+};
+
+int Counted::live = 0;
+
+struct TestNodePool : ::testing::Test {
+  TestNodePool(){ Counted::live = 0; }
+  ~TestNodePool(){}
+};
+
+TEST_F(TestNodePool, TestConstruct1){
+  R::node_pool<Counted> pool(16);
+  EXPECT_EQ(0, Counted::live);
+  Counted* a = pool.construct(1U);
+  Counted* b = pool.construct(2U, a);
+  EXPECT_EQ(2, Counted::live);
+  EXPECT_EQ(2, pool.size());
+  EXPECT_EQ(a, b->link);
+  EXPECT_EQ(1U, b->link->payload[2]);
+}
+
+TEST_F(TestNodePool, TestReset1){
+  R::node_pool<Counted> pool(16);
+  for (uint i = 0; i < 10; ++i)
+    pool.construct(i);
+  pool.reset();
+  EXPECT_EQ(0, Counted::live);
+  EXPECT_EQ(0, pool.size());
+  EXPECT_EQ(16, pool.capacity());
+
+  Counted* a = pool.construct(7U);
+  EXPECT_EQ(7U, a->payload[0]);
+  EXPECT_EQ(1, Counted::live);
+}
+
+TEST_F(TestNodePool, TestReserve1){
+  R::node_pool<Counted> pool;
+  EXPECT_EQ(0, pool.capacity());
+  pool.reserve(8);
+  EXPECT_EQ(8, pool.capacity());
+  pool.reserve(4);
+  EXPECT_EQ(8, pool.capacity());
+}
+
+TEST_F(TestNodePool, TestSwap1){
+  {
+    R::node_pool<Counted> pool(4);
+    R::node_pool<Counted> spare(4);
+    Counted* a = pool.construct(3U);
+    Counted* b = spare.construct(s::move(*a));
+    s::swap(pool, spare);
+    spare.reset();
+    EXPECT_EQ(1, pool.size());
+    EXPECT_EQ(0, spare.size());
+    EXPECT_EQ(1, Counted::live);
+    EXPECT_EQ(3U, b->payload[0]);
+  }
+  EXPECT_EQ(0, Counted::live);
+}
+
+//counts live objects across threads
+struct SharedCounted {
+  static s::atomic<int> live;
+  uint value;
+
+  explicit SharedCounted(uint v): value(v) { live++; }
+  ~SharedCounted(){ live--; }
+};
+
+s::atomic<int> SharedCounted::live(0);
+
+TEST_F(TestNodePool, TestConcurrentConstruct1){
+  SharedCounted::live = 0;
+  R::concurrent_node_pool<SharedCounted> pool(1000);
+  s::vector<s::vector<SharedCounted*>> claimed(4);
+  s::vector<s::thread> threads;
+  for (uint t = 0; t < 4; ++t)
+    threads.emplace_back([&pool, &claimed, t]{
+      while (SharedCounted* node = pool.construct(t))
+        claimed[t].push_back(node);
+    });
+  for (s::thread& thread : threads)
+    thread.join();
+
+  s::set<SharedCounted*> distinct;
+  for (uint t = 0; t < 4; ++t)
+    for (SharedCounted* node : claimed[t]){
+      EXPECT_EQ(t, node->value);
+      distinct.insert(node);
+    }
+  EXPECT_EQ(1000, distinct.size());
+  EXPECT_EQ(1000, pool.size());
+  EXPECT_EQ(1000, SharedCounted::live);
+  EXPECT_EQ(nullptr, pool.construct(9U));
+}
+
+TEST_F(TestNodePool, TestConcurrentReset1){
+  SharedCounted::live = 0;
+  {
+    R::concurrent_node_pool<SharedCounted> pool;
+    pool.reserve(4);
+    for (uint i = 0; i < 6; ++i)
+      pool.construct(i);
+    EXPECT_EQ(4, pool.size());
+    EXPECT_EQ(4, SharedCounted::live);
+    pool.reset();
+    EXPECT_EQ(0, SharedCounted::live);
+    SharedCounted* a = pool.construct(5U);
+    ASSERT_NE(nullptr, a);
+    EXPECT_EQ(5U, a->value);
+  }
+  EXPECT_EQ(0, SharedCounted::live);
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <type_alias.h>
+#include <types.h>
+#include <ttt_types.h>
+#include <go_types.h>
+#include <splitmix.h>
+#include <agents/search_budget.h>
+#include <agents/mcts_agent.h>
+#include <agents/lp_mcts_agent.h>
+#include <agents/tp_mcts_agent.h>
+
+namespace s = std;
+namespace R = rlgames;
+
+struct TestSearchClock : ::testing::Test {
+  TestSearchClock(){}
+  ~TestSearchClock(){}
+
+  void run(R::SearchClock& clock, size_t iterations){
+    for (size_t i = 0; i < iterations; ++i)
+      ASSERT_TRUE(clock.next());
+  }
+};
+
+TEST_F(TestSearchClock, TestNodes1){
+  R::SearchClock clock(R::SearchBudget(10));
+  run(clock, 10);
+  EXPECT_FALSE(clock.next());
+  EXPECT_EQ(10, clock.iterations());
+  EXPECT_EQ(0, clock.remaining());
+}
+
+TEST_F(TestSearchClock, TestDecided1){
+  R::SearchClock clock(R::SearchBudget(100));
+  run(clock, 90);
+  EXPECT_EQ(10, clock.remaining());
+  EXPECT_FALSE(clock.decided(40, 20));
+}
+
+TEST_F(TestSearchClock, TestDecided2){
+  R::SearchClock clock(R::SearchBudget(100, 0, true));
+  run(clock, 90);
+  EXPECT_TRUE(clock.decided(40, 20));
+  EXPECT_FALSE(clock.decided(30, 20));
+}
+
+TEST_F(TestSearchClock, TestDecidedPlayouts1){
+  R::SearchClock clock(R::SearchBudget(100, 0, true));
+  run(clock, 90);
+  //4 playouts per iteration, the runner up can still get 40 more
+  EXPECT_FALSE(clock.decided(40, 20, 4));
+  run(clock, 6);
+  EXPECT_TRUE(clock.decided(40, 20, 4));
+}
+
+//root of the empty board with every move expanded, the first move has 40
+//playouts and the best score, the others 20
+template <typename Agent>
+struct DecidedProbe : Agent {
+  template <typename... Args>
+  explicit DecidedProbe(Args&&... args): Agent(s::forward<Args>(args)...) {}
+
+  bool root_decided(const R::SearchClock& clock){
+    typename Agent::MCTSNode root((R::TTTGameState()));
+    root.nexpanded = root.edges.size();
+    for (uint i = 0; i < root.edges.size(); ++i){
+      root.edges[i].ncount = i == 0 ? 40U : 20U;
+      root.edges[i].qvalue = i == 0 ? 40.F : 0.F;
+    }
+    return Agent::is_decided(&root, clock);
+  }
+};
+
+TEST_F(TestSearchClock, TestMCTSDecided1){
+  DecidedProbe<R::MCTSAgent<R::Splitmix, R::TTTBoard, R::TTTGameState>> agent(100, 1.F, 4);
+  R::SearchClock clock(R::SearchBudget(100, 0, true));
+  run(clock, 90);
+  EXPECT_FALSE(agent.root_decided(clock));
+  run(clock, 6);
+  EXPECT_TRUE(agent.root_decided(clock));
+}
+
+TEST_F(TestSearchClock, TestLPMCTSDecided1){
+  DecidedProbe<R::LPMCTSAgent<R::Splitmix, R::TTTBoard, R::TTTGameState>> agent(100, 1.F, 4, 1);
+  R::SearchClock clock(R::SearchBudget(100, 0, true));
+  run(clock, 90);
+  EXPECT_FALSE(agent.root_decided(clock));
+  run(clock, 6);
+  EXPECT_TRUE(agent.root_decided(clock));
+}
+
+//the same root for the tree parallel agent on 9x9, its children carry the
+//statistics and a virtual loss counts as visits on the way
+struct TPDecidedProbe : R::TPMCTSAgent<R::Splitmix, R::GoBoard<9>, R::GoGameState<9>> {
+  TPDecidedProbe(size_t mc_sample_size, size_t num_threads): TPMCTSAgent(100, 1.F, mc_sample_size, num_threads) {}
+
+  bool root_decided(const R::SearchClock& clock, uint vloss = 0){
+    R::GoGameState<9> gs;
+    mPool.reset();
+    mPool.reserve(R::GoBoard<9>::IZ + 2);
+    MCTSNode* root = mPool.construct(gs, nullptr, 0U);
+    root->nclaimed = root->nedges;
+    for (uint i = 0; i < root->nedges; ++i){
+      R::GoGameState<9> child_state = gs;
+      child_state.apply_move(root->edges[i].move());
+      MCTSNode* child = mPool.construct(child_state, root, i == 1 ? vloss : 0U);
+      child->ncount = i == 0 ? 40U : 20U;
+      child->qvalue = i == 0 ? 40.F : 0.F;
+      root->edges[i].child = child;
+    }
+    return is_decided(root, clock);
+  }
+};
+
+TEST_F(TestSearchClock, TestTPMCTSDecided1){
+  TPDecidedProbe agent(4, 1);
+  R::SearchClock clock(R::SearchBudget(100, 0, true));
+  run(clock, 90);
+  EXPECT_FALSE(agent.root_decided(clock));
+  run(clock, 6);
+  EXPECT_TRUE(agent.root_decided(clock));
+}
+
+TEST_F(TestSearchClock, TestTPMCTSDecided2){
+  //every thread has its own clock, the iterations left to the others count
+  TPDecidedProbe agent(4, 2);
+  R::SearchClock clock(R::SearchBudget(50, 0, true));
+  run(clock, 47);
+  EXPECT_FALSE(agent.root_decided(clock));
+  run(clock, 1);
+  EXPECT_TRUE(agent.root_decided(clock));
+}
+
+TEST_F(TestSearchClock, TestTPMCTSDecided3){
+  //a rollout in flight below the runner up may still land there
+  TPDecidedProbe agent(4, 1);
+  R::SearchClock clock(R::SearchBudget(100, 0, true));
+  run(clock, 96);
+  EXPECT_FALSE(agent.root_decided(clock, 1));
+  run(clock, 1);
+  EXPECT_TRUE(agent.root_decided(clock, 1));
+}
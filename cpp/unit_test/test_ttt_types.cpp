@@ -180,3 +180,14 @@ TEST_F(TestGameState, TestIsConnected5){
   EXPECT_TRUE(state.is_over());
   EXPECT_EQ(R::Player::Unknown, state.winner());
 }
+
+TEST_F(TestGameState, TestUndoMove1){
+  gs.apply_move(R::Move(R::M::Play, R::Pt(1, 1)));
+  R::TTTGameState::Undo undo;
+  gs.apply_move(R::Move(R::M::Play, R::Pt(0, 1)), undo);
+  gs.undo_move(undo);
+
+  EXPECT_EQ(R::Player::White, gs.next_player());
+  EXPECT_EQ(R::Player::Unknown, gs.board().get(R::Pt(0, 1)));
+  EXPECT_TRUE(R::Move(R::M::Play, R::Pt(1, 1)) == gs.previous_move());
+}
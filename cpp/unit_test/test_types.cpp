@@ -94,6 +94,46 @@ TEST(TestPoint, TestCorners3){
   ASSERT_EQ(4, a.size());
 }
 
+TEST(TestPaddedGrid, TestToPadded1){
+  using Grid = R::PaddedGrid<9>;
+  for (uint i = 0; i < Grid::IZ; ++i){
+    R::Pt p = R::point<9>(i);
+    EXPECT_EQ(R::padded_index<9>(p), Grid::TO_PADDED[i]);
+    EXPECT_EQ(i, Grid::TO_INDEX[Grid::TO_PADDED[i]]);
+  }
+}
+
+TEST(TestPaddedGrid, TestBorder1){
+  using Grid = R::PaddedGrid<9>;
+  uint border = 0;
+  for (uint p = 0; p < Grid::PZ; ++p)
+    if (Grid::TO_INDEX[p] == Grid::OFF)
+      border++;
+  EXPECT_EQ(Grid::PZ - Grid::IZ, border);
+}
+
+TEST(TestPaddedGrid, TestNeighbours1){
+  using Grid = R::PaddedGrid<9>;
+  R::Pt p(0, 6);
+  R::Neighbours a = R::neighbours(p);
+  for (uint k = 0; k < 4; ++k){
+    uint cell = R::padded_index<9>(p) + Grid::NEIGHBOURS[k];
+    if (a[k].r < 9 && a[k].c < 9) EXPECT_EQ(R::index<9>(a[k]), Grid::TO_INDEX[cell]);
+    else                          EXPECT_EQ(Grid::OFF, Grid::TO_INDEX[cell]);
+  }
+}
+
+TEST(TestPaddedGrid, TestCorners1){
+  using Grid = R::PaddedGrid<9>;
+  R::Pt p(8, 0);
+  R::Neighbours a = R::corners(p);
+  for (uint k = 0; k < 4; ++k){
+    uint cell = R::padded_index<9>(p) + Grid::CORNERS[k];
+    if (a[k].r < 9 && a[k].c < 9) EXPECT_EQ(R::index<9>(a[k]), Grid::TO_INDEX[cell]);
+    else                          EXPECT_EQ(Grid::OFF, Grid::TO_INDEX[cell]);
+  }
+}
+
 TEST(TestPlayer, TestOtherPlayer){
   R::Player p   = R::Player::Black;
   R::Player oth = R::other_player(p);
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <type_alias.h>
+#include <types.h>
+#include <go_types.h>
+#include <splitmix.h>
+#include <null_distribution.h>
+#include <agents/search_budget.h>
+#include <agents/zero_agent.h>
+
+namespace s = std;
+namespace t = torch;
+namespace R = rlgames;
+
+constexpr ubyte SZ = 5;
+constexpr uint AS = SZ * SZ + 1;
+
+//the search is driven through begin_search, step and resume with made up
+//evaluations, so the model is only asked for its encoders and never run.
+//experience is not collected, the encoded state is never looked at
+struct FakeModel {
+  struct StateEncoder {
+    R::TensorP encode_state(const R::GoGameState<SZ>&, t::Device){
+      return R::TensorP();
+    }
+  } state_encoder;
+  struct ActionEncoder {
+    R::Move idx_to_move(uint idx){
+      if (idx == SZ * SZ) return R::Move(R::M::Pass);
+      else                return R::Move(R::M::Play, R::point<SZ>(idx));
+    }
+  } action_encoder;
+};
+
+using Agent = R::ZeroAgent<FakeModel, R::null_distribution<AS>, R::Splitmix, R::GoBoard<SZ>, R::GoGameState<SZ>, AS>;
+
+struct TestZeroAgent : ::testing::Test {
+  FakeModel model;
+
+  TestZeroAgent(){}
+  ~TestZeroAgent(){}
+
+  //every position evaluates to a tie with most of the prior on the first
+  //move, returns the number of leaves evaluated
+  size_t search(Agent& agent){
+    s::vector<float> values, priors;
+    size_t evaluated = 0;
+    agent.begin_search(R::GoGameState<SZ>());
+    while (agent.step()){
+      size_t pending = agent.num_pending();
+      values.assign(pending, 0.F);
+      priors.assign(pending * AS, 0.1F / (AS - 1));
+      for (size_t i = 0; i < pending; ++i)
+        priors[i * AS] = 0.9F;
+      agent.resume(values.data(), priors.data());
+      evaluated += pending;
+    }
+    agent.end_search();
+    return evaluated;
+  }
+};
+
+TEST_F(TestZeroAgent, TestBudgetBatch8){
+  Agent agent(model, t::Device(t::kCPU), 400, 1.F, 0.03F, 0.F, 7);
+  agent.set_batch_size(8);
+  //the root and one leaf per iteration
+  EXPECT_EQ(401, search(agent));
+}
+
+TEST_F(TestZeroAgent, TestEarlyStopBatch8){
+  Agent agent(model, t::Device(t::kCPU), 400, 1.F, 0.03F, 0.F, 7);
+  agent.set_batch_size(8);
+  agent.set_budget(R::SearchBudget(400, 0, true));
+  //at least one round of 8 leaves short of the budget
+  EXPECT_GE(401 - 8, search(agent));
+}
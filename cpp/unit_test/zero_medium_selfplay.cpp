@@ -6,6 +6,10 @@
 #include <random>
 #include <chrono>
 #include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
 #include <iostream>
 #include <filesystem>
 #include <algorithm>
@@ -21,7 +25,10 @@
 #include <encoders/go_zero_encoder.h>
 #include <models/model_base.h>
 #include <models/zero_model_resnet_small.h>
+#include <eval_cache.h>
+#include <models/inference_server.h>
 #include <agents/zero_agent.h>
+#include <agents/zero_scheduler.h>
 
 #include <torch/torch.h>
 
@@ -35,13 +42,15 @@ constexpr ubyte SZ = 13;
 int main(int argc, const char* argv[]){
   uint episodes = 1000;
   uint batchsize = 10;
+  uint concurrency = 1;
+  bool use_scheduler = false;
   s::string model_config_file;
   s::string model_file;
   s::string optimizer_file;
   s::string result_file;
 
-  if (argc != 7){
-    s::cout << "Usage: zero_medium_selfplay <episodes> <batchsize> <model_config> <model_file> <optimizer_file> <result_file>" << s::endl;
+  if (argc < 7 || argc > 9){
+    s::cout << "Usage: zero_medium_selfplay <episodes> <batchsize> <model_config> <model_file> <optimizer_file> <result_file> [concurrent_games [threads|scheduler]]" << s::endl;
     s::exit(1);
   }
 
@@ -51,6 +60,10 @@ int main(int argc, const char* argv[]){
   model_file = argv[4];
   optimizer_file = argv[5];
   result_file = argv[6];
+  if (argc >= 8)
+    concurrency = s::max(atoi(argv[7]), 1);
+  if (argc == 9)
+    use_scheduler = s::string(argv[8]) == "scheduler";
 
   if (not s::filesystem::exists(model_config_file)){
     s::cout << "model configuration file does not exist" << s::endl;
@@ -58,7 +71,6 @@ int main(int argc, const char* argv[]){
   }
 
   srand(time(nullptr));
-  uint max_bsize = batchsize * SZ * SZ * SZ;
 
   t::Device device(t::kCPU);
   if (t::cuda::is_available()){
@@ -87,92 +99,157 @@ int main(int argc, const char* argv[]){
 
   model_container.model->to(device);
 
-  //the agents will share the same model, but use a different experience collector buffer
-  R::ZeroAgent<decltype(model_container), R::dirichlet_distribution<action_size>, R::Splitmix, R::GoBoard<SZ>, R::GoGameState<SZ>, action_size> agent1(
-    model_container,
-    device,
-    1600,   /*max expansion*/
-    0.2,    /*exploration factor*/
-    0.03,   /*dirichlet distribution alpha*/
-    0.25,   /*noise factor*/
-    rand()  /*random seed*/
-  );
-
-  R::ZeroAgent<decltype(model_container), R::dirichlet_distribution<action_size>, R::Splitmix, R::GoBoard<SZ>, R::GoGameState<SZ>, action_size> agent2(
-    model_container,
-    device,
-    1600,   /*max expansion*/
-    0.2,    /*exploration factor*/
-    0.03,   /*dirichlet distribution alpha*/
-    0.25,   /*noise factor*/
-    rand()  /*random seed*/
-  );
+  using Agent = R::ZeroAgent<decltype(model_container), R::dirichlet_distribution<action_size>, R::Splitmix, R::GoBoard<SZ>, R::GoGameState<SZ>, action_size>;
+
+  //all agents play with the same model, so they share its evaluations
+  R::EvalCache<action_size> cache(1U << 16U);
+
+  //concurrent games on threads send their positions to one server that
+  //batches them, with the scheduler all games run on this thread instead
+  s::unique_ptr<R::InferenceServer<decltype(model_container), action_size>> server;
+  R::ZeroScheduler<decltype(model_container), action_size> scheduler(model_container);
+  if (concurrency > 1 && not use_scheduler)
+    server.reset(new R::InferenceServer<decltype(model_container), action_size>(model_container, concurrency, c::microseconds(1000)));
+
+  //one pair of agents per concurrent game, the agents will share the same
+  //model, but use a different experience collector buffer
+  s::vector<s::unique_ptr<Agent>> agents1, agents2;
+  for (uint k = 0; k < concurrency; ++k)
+    for (s::vector<s::unique_ptr<Agent>>* agents : {&agents1, &agents2}){
+      agents->emplace_back(new Agent(
+        model_container,
+        device,
+        1600,   /*max expansion*/
+        0.2,    /*exploration factor*/
+        0.03,   /*dirichlet distribution alpha*/
+        0.25,   /*noise factor*/
+        rand()  /*random seed*/
+      ));
+      Agent& agent = *agents->back();
+      agent.set_cache(cache);
+      if (server)
+        agent.set_server(*server);
+      //a gpu runs a batch of leaves in about the time of one
+      if (device.type() == t::kCUDA)
+        agent.set_batch_size(8);
+    }
 
   s::vector<float> losses;
   s::vector<uint> step_counts;
   uint64 a1_wins = 0, a2_wins = 0, tie_count = 0;
+  s::mutex result_lock;
 
   uint reporting_interval = s::max(episodes / 10U, 1U);
+  uint max_games = (batchsize + concurrency - 1) / concurrency;
+  uint max_bsize = max_games * SZ * SZ * SZ;
 
   for (uint i = 0; i < episodes; ++i){
-    R::ZeroEpisodicExpCollector buffer1(max_bsize, state_size, action_size, device);
-    R::ZeroEpisodicExpCollector buffer2(max_bsize, state_size, action_size, device);
-    agent1.set_exp(buffer1);
-    agent2.set_exp(buffer2);
-
-    R::ZeroExperience experience(device);
-    for (uint j = 0; j < batchsize; ++j){
-      R::GoGameState<SZ> state;
-      R::Player turn = R::Player::Black;
-
-      auto gstart = c::high_resolution_clock::now();
-      uint step_count = 0;
-
-      while (not state.is_over()){
-        R::Move move(R::M::Pass);
-        switch (turn){
-        case R::Player::Black: move = agent1.select_move(state); break;
-        case R::Player::White: move = agent2.select_move(state); break;
-        default: assert(false);
-        }
-        state.apply_move(move);
-        step_count++;
-        turn = R::other_player(turn);
-      }
+    s::vector<s::unique_ptr<R::ZeroEpisodicExpCollector>> buffers1, buffers2;
+    for (uint k = 0; k < concurrency; ++k){
+      buffers1.emplace_back(new R::ZeroEpisodicExpCollector(max_bsize, state_size, action_size, device));
+      buffers2.emplace_back(new R::ZeroEpisodicExpCollector(max_bsize, state_size, action_size, device));
+      agents1[k]->set_exp(*buffers1[k]);
+      agents2[k]->set_exp(*buffers2[k]);
+    }
 
-      step_counts.push_back(step_count);
-      R::Player winner = state.winner();
+    //records the finished game of slot k
+    auto finish_game = [&](uint k, R::Player winner, uint step_count, c::microseconds duration){
+      R::ZeroEpisodicExpCollector& buffer1 = *buffers1[k];
+      R::ZeroEpisodicExpCollector& buffer2 = *buffers2[k];
       switch (winner){
       case R::Player::Black:
-        buffer1.complete_episode(decltype(agent1)::MAX_SCORE);
-        buffer2.complete_episode(decltype(agent2)::MIN_SCORE);
-        a1_wins += 1;
+        buffer1.complete_episode(Agent::MAX_SCORE);
+        buffer2.complete_episode(Agent::MIN_SCORE);
         break;
       case R::Player::White:
-        buffer1.complete_episode(decltype(agent1)::MIN_SCORE);
-        buffer2.complete_episode(decltype(agent2)::MAX_SCORE);
-        a2_wins += 1;
+        buffer1.complete_episode(Agent::MIN_SCORE);
+        buffer2.complete_episode(Agent::MAX_SCORE);
         break;
       case R::Player::Unknown:
-        buffer1.complete_episode(decltype(agent1)::TIE_SCORE);
-        buffer2.complete_episode(decltype(agent2)::TIE_SCORE);
-        tie_count += 1;
+        buffer1.complete_episode(Agent::TIE_SCORE);
+        buffer2.complete_episode(Agent::TIE_SCORE);
         break;
       default: assert(false);
       }
 
-      auto gstop = c::high_resolution_clock::now();
-      auto duration = c::duration_cast<c::microseconds>(gstop - gstart);
-
+      s::lock_guard<s::mutex> guard(result_lock);
+      step_counts.push_back(step_count);
+      switch (winner){
+      case R::Player::Black:   a1_wins += 1;   break;
+      case R::Player::White:   a2_wins += 1;   break;
+      case R::Player::Unknown: tie_count += 1; break;
+      default: assert(false);
+      }
       s::cout << "Game time: " << duration.count() << " microseconds" << s::endl;
+    };
+
+    //each game slot k takes the next game of the batch until all are played,
+    //no slot plays more than max_games of them
+    s::atomic<uint> next_game(0);
+    auto play_games = [&](uint k){
+      Agent& agent1 = *agents1[k];
+      Agent& agent2 = *agents2[k];
+      for (uint j = 0; j < max_games && next_game.fetch_add(1) < batchsize; ++j){
+        R::GoGameState<SZ> state;
+        R::Player turn = R::Player::Black;
+
+        auto gstart = c::high_resolution_clock::now();
+        uint step_count = 0;
+
+        while (not state.is_over()){
+          R::Move move(R::M::Pass);
+          switch (turn){
+          case R::Player::Black: move = agent1.select_move(state); break;
+          case R::Player::White: move = agent2.select_move(state); break;
+          default: assert(false);
+          }
+          state.apply_move(move);
+          step_count++;
+          turn = R::other_player(turn);
+        }
 
-      R::append_experiences(experience, buffer1, buffer2);
+        auto gstop = c::high_resolution_clock::now();
+        finish_game(k, state.winner(), step_count, c::duration_cast<c::microseconds>(gstop - gstart));
+      }
+    };
+    if (use_scheduler){
+      //the games of the batch are played in waves of one game per slot, the
+      //time of a game is the time of its wave
+      for (uint first = 0; first < batchsize; first += concurrency){
+        auto wstart = c::high_resolution_clock::now();
+        s::vector<R::ZeroGameTask<Agent, R::GoGameState<SZ>>> tasks;
+        for (uint k = 0; k < concurrency && first + k < batchsize; ++k)
+          tasks.emplace_back(*agents1[k], *agents2[k]);
+        scheduler.run(tasks);
+        auto wstop = c::high_resolution_clock::now();
+        for (uint k = 0; k < tasks.size(); ++k)
+          finish_game(k, tasks[k].winner(), tasks[k].steps(), c::duration_cast<c::microseconds>(wstop - wstart));
+      }
+    } else if (concurrency == 1)
+      play_games(0);
+    else {
+      s::vector<s::thread> games;
+      for (uint k = 0; k < concurrency; ++k)
+        games.emplace_back(play_games, k);
+      for (s::thread& game : games)
+        game.join();
     }
+
+    R::ZeroExperience experience(device);
+    for (uint k = 0; k < concurrency; ++k)
+      R::append_experiences(experience, *buffers1[k], *buffers2[k]);
     float loss = train(model_container, experience);
 
     if (i % reporting_interval){
-      s::cout << "Episode " << i << ". Loss " << loss << s::endl;
+      s::cout << "Episode " << i << ". Loss " << loss << ". Cache hit rate " << cache.hit_rate();
+      if (server)
+        s::cout << ". Mean inference batch " << server->mean_batch_size();
+      if (use_scheduler)
+        s::cout << ". Mean inference batch " << scheduler.mean_batch_size();
+      s::cout << s::endl;
     }
+    //evaluations of the model before training are stale
+    cache.clear();
 
     losses.push_back(loss);
   }
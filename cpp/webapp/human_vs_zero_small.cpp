@@ -118,10 +118,14 @@ private:
 
     mGoGameState.apply_move(agent_move);
 
+    //search on while the human thinks
+    mAgent.start_pondering(mGoGameState);
+
     display_board();
   }
 
   void reset(){
+    mAgent.stop_pondering();
     mGoGameState = R::GoGameState<SZ>();
     display_board();
   }
@@ -8,740 +8,316 @@
 
 namespace rlgames {
 
+constexpr uint ZOBRIST_MAX_SIZE = 19;
+
+//stone keys indexed by [player - 1][point index]
+constexpr uint64 ZOBRIST_STONE_KEYS[2][ZOBRIST_MAX_SIZE * ZOBRIST_MAX_SIZE] = {
+  {
+    0xc40b96261f80e1edULL, 0x23b8b744fb1ef42fULL, 0xccc5695674046ebaULL, 0xd8042cc5cc6545b8ULL,
+    0x8297d2f2c29932b2ULL, 0x5435af0fd0350a51ULL, 0x2166e4b031182edbULL, 0x7f07f06150e7b068ULL,
+    0x843ee2cbede9b83dULL, 0xf0ea5b4b1dffb1f7ULL, 0xe940ed6a2cb2dd80ULL, 0x6a8824264180e827ULL,
+    0x49d67252175520d2ULL, 0xf296882b1954de2dULL, 0x747fac10779bc4fcULL, 0xa76cfefa4152897fULL,
+    0x616aaf06198847c5ULL, 0x3f3da034e5bea1efULL, 0xc16b6633a6e4cb7cULL, 0xd2d5c0a89a3d91a0ULL,
+    0xd026020b83ad9020ULL, 0x9b3fae0285b95d97ULL, 0x97da6fd67ff4d893ULL, 0x92d17687879fe558ULL,
+    0xd4659b2e654511abULL, 0xaa8e5183eb9f85daULL, 0x95d924533d626d1eULL, 0x8d31bd5c7a6cfe78ULL,
+    0x48fe9e78a89e33dcULL, 0xd31b4db879bb0fa1ULL, 0xf92428d39c8f5251ULL, 0xcbd0503f4251c6baULL,
+    0xecf07c9cebaf2400ULL, 0x4c9c9585a00d038dULL, 0x6fefa2de52e58ec1ULL, 0x7b2ff5292432adc6ULL,
+    0x3af7680666babf22ULL, 0x71b422dcf8a61443ULL, 0x6a38ff2c149e62dfULL, 0x22872407f591e783ULL,
+    0x1d4d86484059cf9dULL, 0xfd41e228b9509a59ULL, 0xeeb4ab34dbcd3516ULL, 0xb3dd5900a4cefb1cULL,
+    0xab1b42877be40c2cULL, 0x961672b0443f723dULL, 0xd3793f328cc47f22ULL, 0xa4472e2411aec6c7ULL,
+    0xf43f6c38b3d75d04ULL, 0xd0397ebde3a68129ULL, 0xf5ace8f897f4f25aULL, 0xebea6201ec797702ULL,
+    0xdb95f59c2ea2260bULL, 0xaf12df56046cee7bULL, 0x1544cfd7c5f7cf99ULL, 0x58592c69087e3613ULL,
+    0x3848c3d7cd01dc6cULL, 0x4b743a27293cf9f9ULL, 0xb78d7781e04fb177ULL, 0x8315ed820e2405cbULL,
+    0xc3d647b86c247052ULL, 0xa847898136fc0bedULL, 0xd39530a951e6f4e2ULL, 0xc893ceca1ed4c989ULL,
+    0x7c49b9e6ad936c48ULL, 0xb067c991369e84b0ULL, 0x7d93f27f77c82f06ULL, 0xb3c667640eaa3eeeULL,
+    0xa4b634549f559a4eULL, 0x290856ba871e48f5ULL, 0x4ddff9c84f48e532ULL, 0x4299cffa92204803ULL,
+    0x5c7818084626d29bULL, 0x3a69313bb431edfeULL, 0xac44a7481756d123ULL, 0x86395a46c3219eddULL,
+    0xc6f4431fe89ef37fULL, 0x4a7460a3d9d1d816ULL, 0xae411dba929f9807ULL, 0x234b936483e2a94eULL,
+    0xb57c80208e063a2bULL, 0x7121fa9a4ca7940bULL, 0x6c9368d29dc73921ULL, 0xefe4a83db2d86e46ULL,
+    0x7926dee8e2f4487aULL, 0x687e65a3a176e385ULL, 0xdd124c917ee7ffe5ULL, 0xec64589bacb48decULL,
+    0xeba0308dd7b93d1eULL, 0x84c50fa78e191b09ULL, 0x977f500de57955e3ULL, 0x8f91668f420f71a4ULL,
+    0xb98baefd48dd84e4ULL, 0x6ded553a02909f60ULL, 0x4e91306f1ecef184ULL, 0x3748f17b0468db79ULL,
+    0x83a96aa8c5161120ULL, 0xb24b3a36fcfea34bULL, 0xfcf955b669943fa9ULL, 0x308f2584ab9e47c1ULL,
+    0x79180fa6b2bf0bf5ULL, 0x5b185153d2e6ecc9ULL, 0x3f09eeb0c3683d0eULL, 0xcaffeb428d3a39d0ULL,
+    0x56f16e8255882f9cULL, 0x69abb0b88472ddcbULL, 0x57b5cf37b98b166bULL, 0x51926e4295dd9f3dULL,
+    0x27331cae57c3053aULL, 0x98664a9069a8ec12ULL, 0x2b236f703bec9c06ULL, 0x9a0cf8734f2f5ed9ULL,
+    0x6a1e32f7b42989c9ULL, 0x23106b2977576550ULL, 0x53a3065b334079a0ULL, 0x242343107b7725b1ULL,
+    0x83af17a401f15a4fULL, 0x44d86830c35b5613ULL, 0x406974e28c5f8340ULL, 0xca71974cfe6dc96eULL,
+    0x28514a33038b9dabULL, 0x18ce80a2d1aa2677ULL, 0xc7a94715457213c3ULL, 0x88eb0f127eb145b8ULL,
+    0x9ef54cca4d296aa7ULL, 0x354c4a0b462680abULL, 0x24ba4ccb659a7068ULL, 0xae4b0f83bbb4a1e9ULL,
+    0xc13686eb00766fb6ULL, 0x86f2b1fff5c622b5ULL, 0xb8c0239582cfad1fULL, 0xe771938b0dd2fa70ULL,
+    0x3724e2b7efa2b495ULL, 0x8a1742ea6439ab15ULL, 0x221623f7ce101eb5ULL, 0x540fdd3694deccb2ULL,
+    0xc716fdd11afb49dfULL, 0xeef9464a44c7952cULL, 0x31a5c7af6ded4336ULL, 0x1c90285da279b08bULL,
+    0x81604772f14a4d39ULL, 0xf50e6a5d5df24d78ULL, 0x9584f619a1e61dc6ULL, 0xa5f0c5d49c82ca3eULL,
+    0x4c0e6275703a9049ULL, 0x4dd706159214f628ULL, 0x6f78b6cdc2c1f7ceULL, 0x47244ebfce2fde00ULL,
+    0x6e0aadf3fdbc80a7ULL, 0x4fa2cd3aedbb9c46ULL, 0x40024c41fe5aa609ULL, 0x42d73043bf46548eULL,
+    0x9e7dad6848e3fdfdULL, 0x3b7b0c8bbf37b050ULL, 0x1f8225d9d5c195dbULL, 0x96169aec80071157ULL,
+    0x777fe04a41dc0bbbULL, 0x82454f54aff3b4f7ULL, 0xae206c0c9178232bULL, 0xf175908d6057e48dULL,
+    0x690decaf52b09759ULL, 0x68ac9a19751ec971ULL, 0x9d1c4095d9d78954ULL, 0x1c2ab20823e7818fULL,
+    0xe5bcd2c9e61d23a7ULL, 0xee694d889bfe3100ULL, 0x1cebc8b39440fc7bULL, 0xa7a833a9371837b4ULL,
+    0x401fc492d6882984ULL, 0xdb63ab6555d11b48ULL, 0x4be5422067be8503ULL, 0xf306fb89a3765aecULL,
+    0x92554cdd16a62f31ULL, 0x2cd27d5c4d0a66d6ULL, 0xa279a7a0d4f30f5dULL, 0x1c151a69da3c5857ULL,
+    0xd9866ea7e47680c7ULL, 0x4043a65a0c3c04aeULL, 0x61c0636e8c6674b7ULL, 0xe9b7207dda2d5036ULL,
+    0x9981055e08632b49ULL, 0x1db71359b6eca7efULL, 0xe1e074441f018ac7ULL, 0xb9ac686771ed081fULL,
+    0xb1a46060b87829d9ULL, 0x46db6361c5834fb5ULL, 0xd3a13f2d36f52b83ULL, 0x67754237dfc18554ULL,
+    0x9079e56bc94fc8d2ULL, 0x11587d1dc9c77e86ULL, 0x910d278a4037635aULL, 0xfdf78c801bffe1b7ULL,
+    0x43b28eab1b3d8747ULL, 0xdf100d5b29ea8584ULL, 0x4cbb0e5d018ab72aULL, 0xfe8584161a4f47b5ULL,
+    0x13236ecc67f5d1edULL, 0x2f575555e2a9c715ULL, 0xd8eddf578b535b44ULL, 0x6dfd2ac14af12402ULL,
+    0x525d9450904d648fULL, 0x1a4156c43b663ec7ULL, 0xb3d56ee1d66cd29cULL, 0x2c164331b7590c76ULL,
+    0x7cabc0d967130a73ULL, 0xb4de436745fbb040ULL, 0x6217c0d7370798dbULL, 0x677ec1c6ef610e79ULL,
+    0xbfc0dfbc2280e43cULL, 0x8b18c0593aa7f94bULL, 0xb6b5a8d2aae6f204ULL, 0xff7290ad014c62a1ULL,
+    0x70a195240253df14ULL, 0xdff2e03ae40e1e90ULL, 0xae9261f6f059c2dfULL, 0x3bbdc3b109d24b9cULL,
+    0x67b377bf2ed50a15ULL, 0x3bb636f2eabb2a39ULL, 0xe981d5ef2c8321adULL, 0xf8f318e4c6ba7e7cULL,
+    0x50fb64c58c1d9219ULL, 0x90e795d7749cd253ULL, 0xe9d29ba7e8ea274cULL, 0x6d8edcab1cbe3adbULL,
+    0x702374a54597ecaaULL, 0x1d745bf761e1c5ffULL, 0xd444614e08317539ULL, 0xc769cca4068eadd6ULL,
+    0xa12e5bfb6d78ccfaULL, 0xe92ab2cffbb6c79dULL, 0xa889758c2d334a8eULL, 0x6c4ae80898c98b52ULL,
+    0x559303164815a577ULL, 0xedd92deb09bc4c74ULL, 0x4d196cd3cf3e3260ULL, 0xf33835227920a4f8ULL,
+    0xc60badc382d7a101ULL, 0x9700c919003df34fULL, 0x83cc3e5e3941d1d6ULL, 0x2d445d750c8c61f7ULL,
+    0xa4f2ef41698ec55aULL, 0xc21c642fdfa1d99aULL, 0xc7f83074acf1a3e6ULL, 0x1395c431bca3c92bULL,
+    0x49af9f7d574f7a29ULL, 0xa00d8dca8284aeccULL, 0xbd63310ee790de05ULL, 0xc614ac9266cd1af0ULL,
+    0x24bb4f2959c91947ULL, 0x81473c4582b991f3ULL, 0x775048cc7fbc017cULL, 0x84000033b03e4143ULL,
+    0xaba005803655cabbULL, 0xe8ca60b4138ba211ULL, 0x5af745781b6a50e5ULL, 0x557ca9d3e60d1829ULL,
+    0x1f91f90e2c4c74eaULL, 0x525970cdd4915f23ULL, 0x15ee3334680fd225ULL, 0x92e9af776662a6f3ULL,
+    0x477b113787530e60ULL, 0xf5a04e569a623ca1ULL, 0x545edcec13a376caULL, 0xe49b74c069dbfe36ULL,
+    0xc46bec575b599070ULL, 0xc85274c9a134cf71ULL, 0xf3e09373e1e17d15ULL, 0xdcb9c9189b8ef09bULL,
+    0xe54c23817efd0266ULL, 0x402dd6452c7fb744ULL, 0x979a4154b5e75715ULL, 0x9c12619e0b427118ULL,
+    0x5531b8148bb67ab5ULL, 0x445c34547f692af0ULL, 0xd236ff20bab2392bULL, 0xa87fc51d7267b858ULL,
+    0xf1c914b849ef54a9ULL, 0xdec6aabe42c4d9d7ULL, 0xcd6ab61adf2811eeULL, 0x718ec934ac27db42ULL,
+    0x73894bc59dd8353fULL, 0x9217a6b3cdb93f10ULL, 0x9e14844ca976ee35ULL, 0x4772f94ba6bf3081ULL,
+    0x5499d92fcf45343aULL, 0xec54cdf9d827733dULL, 0x54d3f28b9c489777ULL, 0x76259b50b2c64548ULL,
+    0xbd1c54a4f005f973ULL, 0x5adced5d0c26b227ULL, 0x3680a66afd8edf1fULL, 0xc6e987b28a5704afULL,
+    0x5ce10031caf7e6c5ULL, 0x45e169c993a088c8ULL, 0xce3c3bc0d7de211eULL, 0x2d919c8209e1cca3ULL,
+    0xa685e91d802a2b4aULL, 0x2a9fb5bff683eea9ULL, 0x212562b355e785b0ULL, 0x97db7668fdea4dd5ULL,
+    0x14ad95716dc42986ULL, 0x7ece0c981f3a5d12ULL, 0x48b8c3aa3adb304bULL, 0x7c25543c49049cf0ULL,
+    0x1c8751b648d852cfULL, 0x13385ac338be6c3bULL, 0xad10e08bcc900271ULL, 0x10f81c40639b9dd3ULL,
+    0x6247bb9ab2543d02ULL, 0xfaad66be3a41ab75ULL, 0xd7b7f1b733bb51e1ULL, 0x4fff4a54f55a7cfaULL,
+    0xbd88a07681e0c95fULL, 0xde422cfd458476dfULL, 0x83bdfdc330795a5fULL, 0xe2f1d5a984f6511eULL,
+    0x84278e01023fc18eULL, 0x55f397ca93a36827ULL, 0x60f4a1c7b4053044ULL, 0xc7f97230a0ced184ULL,
+    0x581f9f5f96d9d5d9ULL, 0xd37216f525c44166ULL, 0xa6483ac7bbc02153ULL, 0x61c2442a60870d15ULL,
+    0xc9cbeb9ee257e5cfULL, 0xb7962482585bf2b4ULL, 0xeba85cfb83d61f65ULL, 0x351d410178e66c0aULL,
+    0xa33fa339b55b0463ULL, 0x90b17c4a8524b014ULL, 0x32ca8c0bee03a3b6ULL, 0xde5541baf4ebc5b4ULL,
+    0xc8ddc142fbecaeb9ULL, 0x341ff179dda2f32bULL, 0xffc936ee7ddfb2c0ULL, 0x96346cb1211eeadaULL,
+    0x7e06baf0b1f30f1bULL, 0x1f299b952ca5bbfaULL, 0x4856cec21a468e46ULL, 0x787ca31620ca3b95ULL,
+    0xea128933b59090d0ULL, 0xecb9b5e97daaa356ULL, 0x15f6e1855041ee7dULL, 0x1e51756047a2373dULL,
+    0x7e5ee276ea0c65baULL, 0xa4a9e73c95d93a4cULL, 0xe658a4473d18f9b9ULL, 0x4a7f164d6cf1ee41ULL,
+    0x5214ee6cdfce4ad6ULL, 0xfcd6f8904894e41dULL, 0x6dc732e3ab997254ULL, 0x91be16ff47ede559ULL,
+    0xd81b7d0ee9a29ffcULL, 0x9990e5c5adb4f52bULL, 0x78f680d9e9d2f52aULL, 0x8ac83c23de411204ULL,
+    0x5639d81940d08992ULL, 0x43e6ef88b0f37f79ULL, 0xc9491a2e811875c8ULL, 0x6ead173eb32f2aa3ULL,
+    0x67a1400ce7ce5dd5ULL
+  },
+  {
+    0xd0e2a3b52dbf3eb4ULL, 0xeced9628fb9948f1ULL, 0xcebb18b6a10eecb2ULL, 0x99bfa1099945442fULL,
+    0x8ca65068ff854336ULL, 0xb249e0ad688781eeULL, 0xc509ba1c9e951c25ULL, 0xe08d5ac35d9749b5ULL,
+    0xebbbc5119c1e753fULL, 0x4d560a3e96c130efULL, 0x5aa9d5630bdcb78aULL, 0x418618ef946f1968ULL,
+    0x4ee287689362a2cfULL, 0x18280d0b372c93c1ULL, 0x3f5760f54b72f955ULL, 0x3573517e3c69fa7cULL,
+    0x7d5468a504e21b51ULL, 0xdd353bc7e4e3c0cbULL, 0xd12364057c6ac1b7ULL, 0x8fed1d849b240f6dULL,
+    0xf335338883170e3fULL, 0xa5eb4c1c36c2a1d4ULL, 0x47d5332069024aecULL, 0x4798023a7a27e943ULL,
+    0x4dff0f3cbdc27997ULL, 0x39497f73e8c81694ULL, 0xb8e0715a9de727e4ULL, 0xa2e5882fba95554eULL,
+    0xfbde81a2a841638fULL, 0xc46c44b722c11910ULL, 0x2359afe53a184632ULL, 0x6b6f092f94cf99d1ULL,
+    0x173f9e974004a3f8ULL, 0xa57684888fec3bccULL, 0x5746ce56af1f9a5dULL, 0x6d422bbb28bb0a4fULL,
+    0x8291d7e840382833ULL, 0x6d61d14d02ec27acULL, 0xd42b15aee00ff4f5ULL, 0xc06b6b669a4877dfULL,
+    0x7668cfed0b483439ULL, 0x1783c071692f7057ULL, 0xe9d6f794acc7f417ULL, 0x122d6b3e16637e6bULL,
+    0x545dba923847872aULL, 0x5efad13fa232b755ULL, 0xf287b1e9f21b3578ULL, 0x12371a7f9ca78662ULL,
+    0x68e96c947c58bd66ULL, 0xd614de26b9562336ULL, 0xee6a6a5a48d0d017ULL, 0x3e88c8efa6612565ULL,
+    0xa0b977438abefceeULL, 0xc8fd34ac25f35f3eULL, 0x8649c4929e653ecdULL, 0xf332ab4c18784103ULL,
+    0x325ef2292cb801e5ULL, 0xd1547d999afcf0d3ULL, 0x9c6b75526d1896d9ULL, 0xd67159626393fc0bULL,
+    0x59090ac0b389024fULL, 0x49872a495866743fULL, 0xd8b94e73d24fd6f3ULL, 0x19c00f5adac1862eULL,
+    0xf4693c341d47552bULL, 0xca909dff0401b1d5ULL, 0xa8455805d8fb1c35ULL, 0xf9c0e73023577b6aULL,
+    0x3d9d7a7725b46230ULL, 0x170db4e715a6daacULL, 0x4eef104e49c18279ULL, 0x66c20e3e14ace4d7ULL,
+    0xe6c7b51f96d19458ULL, 0x2f92ff8fe615cea5ULL, 0xe0279ee766c1e367ULL, 0xdbabdbc38a6d87f8ULL,
+    0xb4c8a77311b7744cULL, 0x3606c49e15ba92ceULL, 0x57e02a02805e1a11ULL, 0x3d7638ae1c82f022ULL,
+    0xbe2d30794994439cULL, 0xbc73e56893406775ULL, 0xa66fa464de1ec257ULL, 0xb36ad18c35e3d02eULL,
+    0x9b116360f5f456afULL, 0x81b2824f40e1a085ULL, 0xb4308d46236cee6aULL, 0xaf586823b1bce790ULL,
+    0x4b692161381b2f6fULL, 0x76c123d7b11c2f2dULL, 0x5faa54a7ff9f1559ULL, 0x36e4cba62d654056ULL,
+    0xf776c9057018e342ULL, 0xbdf962300c8d3f89ULL, 0xca30261d24fba7eaULL, 0x7a29a9da0591b5bcULL,
+    0x8d736a233c18f4f9ULL, 0xae19b5d7033b8fccULL, 0xef4cca0735ec1ad3ULL, 0xd782562465661af6ULL,
+    0x7931d3d0e6bd440eULL, 0x6aa55de79e5669b3ULL, 0x9fdbff5c0ad2553fULL, 0xf1452c7c34feaf03ULL,
+    0xd0fd89393b197e62ULL, 0xd6e90a7f68973c07ULL, 0xdb315e475929f55bULL, 0xf4cba2c8239909deULL,
+    0x6f90e87234086a49ULL, 0xa828ced8b7eb1f1cULL, 0xdb64626c3cb28b77ULL, 0xcfaf87557fd7c0acULL,
+    0x70d51a05122191d3ULL, 0xb674a76fb1b5f239ULL, 0x51b7ef6f47623442ULL, 0x950c2b507d89e0faULL,
+    0x930e159939aa9403ULL, 0x3158f33f8fc7dc24ULL, 0x35b398912a3519aeULL, 0xfcbb54f4334962e9ULL,
+    0x3c918fa8dc8bf62eULL, 0xd29b9decf80a554dULL, 0x67d215fa92d9718dULL, 0x9dea181d4b439283ULL,
+    0xc809fc50a25e963dULL, 0x6da6c963269468ceULL, 0x4bb68a8bf2ddf70aULL, 0x2db1abcb7e0fb381ULL,
+    0x7555d43c8af6cd76ULL, 0x301651916cb44476ULL, 0xfa3bd3fb79a9e92cULL, 0x55695a1a013b39f4ULL,
+    0x38e34354502dded6ULL, 0x5e2d40b0f538df91ULL, 0x25cac4396f9aaee2ULL, 0x21e9e06ecd244887ULL,
+    0x40f405de3117c9caULL, 0x8a0b75e19b9ebbe3ULL, 0x953d3a92d6abcdb4ULL, 0x224688948a321c61ULL,
+    0x14be15c3da04d8a9ULL, 0xb67a2faf247c9f3cULL, 0x8f4b4d7a34be6f9fULL, 0x2fcd19ead8e029e2ULL,
+    0x5c96bcae2881f0afULL, 0x7c059d686088d737ULL, 0x461f660d2a2f2436ULL, 0xe1506b50969215d5ULL,
+    0x50b4405df8904b51ULL, 0xafc76d58a19f303fULL, 0x6ba8a20579bd9ff8ULL, 0x91ac02d0f4c30295ULL,
+    0x99b0d6dfe5255bffULL, 0x22f52292fc98e53cULL, 0x71e1e0f1a212d05cULL, 0x8d4956c376725535ULL,
+    0x95ff24c586922c00ULL, 0xf4bd24b1f319c8e7ULL, 0xb5f94524ea82e93fULL, 0xa81fcd4558bfa428ULL,
+    0x6b0ad19b852ecf04ULL, 0x6329fc1ff64bd8cbULL, 0x5e4e34b64d24934fULL, 0xf896ea1025c29e41ULL,
+    0x621140d638c0d32aULL, 0xfd7ee8450399101dULL, 0xd667bf983b749bc0ULL, 0x9069b8785d8b4b61ULL,
+    0x1ad1b665c8563a32ULL, 0xf13c431e15360898ULL, 0xed953f430b0ecb63ULL, 0xfc57a23e92a6ee6bULL,
+    0x3154f2fa6db1964eULL, 0x2589c19587d804dbULL, 0xd7920b6e6b73b887ULL, 0xe5caed7e50a224a7ULL,
+    0xc15ced24fabad972ULL, 0x29ed0336564b3a89ULL, 0xc4bd3da061bc4f93ULL, 0x94aae802cfc0c387ULL,
+    0xec6393546ac34210ULL, 0x86263a52a04d5467ULL, 0xf3845af9ec198ac1ULL, 0x2f8b4e49a15c73e4ULL,
+    0x2c6bc962278b532cULL, 0x610af059af4cc90aULL, 0x7e25655e29c41724ULL, 0xac19e6e829cf13c6ULL,
+    0x565f6e6b4c1e9704ULL, 0x7d6d4287446ce7e0ULL, 0xaabbb956d3ec80e1ULL, 0x59cbcdc702363e51ULL,
+    0x193f9be02d845199ULL, 0xaa760aa225a587e4ULL, 0xeffa20e90e0f5800ULL, 0x6ff142ab5697b2b7ULL,
+    0xdb51358c6e2d1643ULL, 0x33aebec37b99d72fULL, 0x332d357a9696a2ddULL, 0xfb8e6c3a00bf457bULL,
+    0x42ffb8a5dc0684cbULL, 0xd9fb1b33c856a439ULL, 0xc0c23ff7cf8421ccULL, 0x2385c7cf56b6ab96ULL,
+    0xb5584a3729ab0abeULL, 0xabb5d416c27a721eULL, 0x788af03329ea1870ULL, 0xc30ea11a5fe61428ULL,
+    0x6464026a05989a6cULL, 0x56d33d891cef6317ULL, 0x9bd7ccea5c1e165eULL, 0xc93c7f2290eb8a29ULL,
+    0x7e46be394bc00ef0ULL, 0x577578b6dd86d3c7ULL, 0x678442ecd1546168ULL, 0xb96fabc622fa5501ULL,
+    0xb72cc145a192a6e3ULL, 0x68418d24b314f1b6ULL, 0xf60ec7f68f7475bbULL, 0x3df1e69020361afeULL,
+    0x3417db40023596acULL, 0x10b9cb97b1c12c34ULL, 0xd0a9949e0d8b38d2ULL, 0xd1705c57d10b16fcULL,
+    0xc38655812d234800ULL, 0x1fe3e9472f646f5cULL, 0x1cdbe5d149a48fd6ULL, 0xd58b4cf90dad1809ULL,
+    0x89cde1a7b00c11d4ULL, 0x41a45944c5eabecbULL, 0x5db055ccab0a4d53ULL, 0x808a258d74746a66ULL,
+    0x7adf5c1d470f1f4aULL, 0x4552e2d0161afe64ULL, 0xef5a30732b363e16ULL, 0xc7d41937c564bbeaULL,
+    0x75d46cbc2a7c7644ULL, 0x1cd2385865ae70f3ULL, 0x307cb2bf4153176bULL, 0xae3966899fd8c274ULL,
+    0xfddaa1f133c01acbULL, 0x95960bc92768eb8dULL, 0xb5409b9105a64f5cULL, 0x59e8d7f7d72d99d6ULL,
+    0xeaf9246d610f7934ULL, 0xc0cb60226e217cafULL, 0x7ae305401fa1b632ULL, 0x41c3fafd499590fdULL,
+    0xd05901adf67c5a78ULL, 0x6de07517c868b462ULL, 0xc7c1a7b5dd8716fdULL, 0x8cb5533681fcbbd8ULL,
+    0xef0cdcaa3cd3bc01ULL, 0x4ec32b44e878b408ULL, 0x26319eaaf1ef691dULL, 0x82f53518fdf45dd2ULL,
+    0x566073c0d12e5a26ULL, 0x54aaf003e8cecdd8ULL, 0xca5b22bfac44c7fcULL, 0xab34308607549f78ULL,
+    0x9d7533a37d192cd5ULL, 0x9190ac723ef99ed0ULL, 0x9b1f2f486596aaedULL, 0x53f9e5410ae05c6cULL,
+    0x2bb19fd7f4772c2dULL, 0x8f4d9f606e8753b5ULL, 0x1e7df58622da5306ULL, 0xe282d1edcae59dceULL,
+    0x3328c19a39ac1174ULL, 0xd324bacd9b7f9cd7ULL, 0xfa38a3b53f13c5fcULL, 0x9b249f8388df67c6ULL,
+    0xaf63014853e98e20ULL, 0x1594dbd308b9e31cULL, 0x2a1a296c92384c74ULL, 0x5603476aa1500226ULL,
+    0x818872d30a25217eULL, 0xb04de737fcfc3091ULL, 0x3127d53ad890b610ULL, 0x8440f4a9ce790ab3ULL,
+    0xde343bd264c62594ULL, 0xba9ff330770bdbd5ULL, 0x59b7ba88eed839f1ULL, 0x8a6254a668d7543fULL,
+    0x42ae43994d823ed7ULL, 0x13f33cdeb83330f5ULL, 0x7c58aa56ee9b1e0eULL, 0x9500655d5d4ba1b7ULL,
+    0x588931f686546976ULL, 0xa60f840a1934a1a7ULL, 0x24140d80114d4332ULL, 0x9f3035df1a1b21ddULL,
+    0x5d2b7d3a8c70c41dULL, 0xe084cfaaefd42ebdULL, 0xf86800fdd81fd5c0ULL, 0x52d7330318157cc9ULL,
+    0x17ef416babcf6834ULL, 0xa7716581c23d8a23ULL, 0x1e64dfc64fe48d6dULL, 0xc925734e4c44b316ULL,
+    0x7015c3b504a328f7ULL, 0x2a9d74c05e555a87ULL, 0x32277b2fe2dbf157ULL, 0xd14a4c503f4af46aULL,
+    0x96cb0d0b0ef1375bULL, 0xd829731a7ace7ad5ULL, 0x19edc369605daa20ULL, 0xbad3ceb8a4302e48ULL,
+    0x786506159449cb4cULL, 0x651bd76b3e6b510aULL, 0xb15e550f32ab9a06ULL, 0xea3020f231686d51ULL,
+    0x1ea2cbd424d95456ULL, 0xad2667cd1fcd6ce0ULL, 0xa3c6bb3dfb78d95fULL, 0x2300d554c6e922c9ULL,
+    0x1e19d4a943514765ULL, 0xae4ebe25ad73ad41ULL, 0x9b675425dcc031c5ULL, 0x1f3e0bb2b852c529ULL,
+    0x8fbe83c9ed94358cULL, 0x148e57906131dcdaULL, 0x79b9c0541d38a110ULL, 0xf0e7de72da8cd7f6ULL,
+    0x938f742642ac08edULL, 0xfbbc2fd032fe2213ULL, 0x8d05eda68eb24622ULL, 0x32ea9428653e0607ULL,
+    0x4d83c8966e6bbcd2ULL, 0x6345de3dde605205ULL, 0xeac77c0e066c2a68ULL, 0x7eb5e8647bff34c5ULL,
+    0xd05d1484980293e8ULL, 0xe0006fa9337d1488ULL, 0x46350d9412ed27b4ULL, 0xee9f13f09cbc3d6aULL,
+    0x700f6274ee783c8fULL, 0xeb41f814a059edbfULL, 0xaad804e699b69bc0ULL, 0xebb89f82de54ee14ULL,
+    0x9f32d9a4f929041fULL, 0x6e1a8bbb47052495ULL, 0xae5499a9e71fcc6eULL, 0xb22dfbddc4ddbe48ULL,
+    0xcf2d820f8984866cULL, 0xcbd8b82893c4a573ULL, 0x2f4a31149af8126dULL, 0x59ab368061f22d7dULL,
+    0xe2a23951bd1edb1eULL, 0x13a63660ed47e060ULL, 0x6c2e68ab34b5d61aULL, 0x8c1380b5fac29345ULL,
+    0x48a806d87f042904ULL, 0x448107d80d54c268ULL, 0x83f6b3d38f942b51ULL, 0xe5c020b0e7753ba6ULL,
+    0xe8c44b7f268df67aULL, 0xb938c5d09f1e02bdULL, 0xd1ae94681ae1907fULL, 0xd28cae6ffde54307ULL,
+    0xd33ac2cc8b73a1f9ULL
+  },
+};
+
+//ko point keys indexed by point index
+constexpr uint64 ZOBRIST_KO_KEYS[ZOBRIST_MAX_SIZE * ZOBRIST_MAX_SIZE] = {
+  0xc273b22629093c0cULL, 0x6adf190ad00ec5c3ULL, 0xccd9cfcbdb387e19ULL, 0xdebd58fafb624ef9ULL,
+  0x23071f30253bbef3ULL, 0x275c7118d39150d8ULL, 0x49ea6332407289d1ULL, 0x8939374b995d18d1ULL,
+  0x837aae15fd4fa31bULL, 0xa9577348a41471e0ULL, 0x206fa9bb6ec6077bULL, 0x562baa71ecbb3aa0ULL,
+  0x8bcb889a8f30d0caULL, 0xaf0a1633aa20dfb2ULL, 0xfb178b304079fb30ULL, 0xb46872733cacb7a9ULL,
+  0xebdfd1ecb82a6974ULL, 0xe2dec54d8ef7eed6ULL, 0x93986376ad3cb131ULL, 0xb4099fc86997c6d1ULL,
+  0x47ea992c47d3d195ULL, 0x14ecef2dccbd3d3eULL, 0x123b24c30e38e337ULL, 0x4c0737cd6b407192ULL,
+  0xe6cd4125f68bae33ULL, 0xcfbb13672e75b669ULL, 0xf684b194450274f5ULL, 0x9d9f97c5e4389792ULL,
+  0xbf650352433de743ULL, 0x9e51076e7a25112dULL, 0xe7f75d9a297c9ac3ULL, 0xce8c410c02a2a872ULL,
+  0x4cf76626c1a56856ULL, 0x7c964e018773b4aeULL, 0x475958099ab7f6c2ULL, 0xcd2b31289252e136ULL,
+  0x4d395d9be8c88345ULL, 0x9b94af1113648d17ULL, 0x28fbca6e3b4eae6eULL, 0xfc3e18098811798fULL,
+  0xd588494d3b78e7bdULL, 0x6284fd19109f08f0ULL, 0xf107774963acfbf1ULL, 0xe49a6688c4418b44ULL,
+  0xf616072413aa6134ULL, 0x7b3987c7db5f363dULL, 0x6400b2cc78155a45ULL, 0xc53d744cf18ed92eULL,
+  0xf2f4c2ec15fbde94ULL, 0xca7f4518635536d0ULL, 0xe2bf1467a1b986b2ULL, 0xec232ca527ccc6b5ULL,
+  0xdb43638658469405ULL, 0x2b697cffc50b8731ULL, 0x7df2e3eed151e31aULL, 0x2b4fe288fcca0a21ULL,
+  0x42ad8beeb84719f7ULL, 0xf51c7cd83ed0080aULL, 0x9653ce8c51033d86ULL, 0xcc752c9adf2c0db3ULL,
+  0x840c643a7e49498aULL, 0xdb07def895e3f57aULL, 0x817081fe1bbca4f2ULL, 0xdf5e3d1065b019f9ULL,
+  0xe1385ea219aa2609ULL, 0x6c9594f8a1051edbULL, 0x7d995e4c618536fcULL, 0x615800b6b54529a1ULL,
+  0xa37882311a01329fULL, 0x229fd3039ee4a96dULL, 0x1c442d8ea9b7c432ULL, 0x97e829d5f068bfcaULL,
+  0x40decc5045b7a293ULL, 0x7e842ebc73a4a4e2ULL, 0x13590fbba45d9b88ULL, 0xe5a16865dfbb5ed7ULL,
+  0xfa18ee0234944d97ULL, 0xe7ff4f135ba38c5aULL, 0x309910c3beba7eedULL, 0x9d927d9b413c00e6ULL,
+  0xa07f0427140bba7bULL, 0xc878160ff960441eULL, 0xe378f99f6a6310beULL, 0x1ebfb8ce647f946bULL,
+  0xe3b12b412d04f8f4ULL, 0xa48b982c6f86f116ULL, 0x9aa2a2957c03e687ULL, 0xcf3aa5ccf3c57a98ULL,
+  0x3401915b90d63ed6ULL, 0x1a4ef709930ec79cULL, 0x7491024ac1187516ULL, 0x2162cd3261a426bbULL,
+  0xe2310adf8320edc8ULL, 0x6790c2d11972e176ULL, 0x32c7485296fbf61dULL, 0xfdeb8955800236c7ULL,
+  0x7dae7df01f7a555aULL, 0xfc773213d62f6a66ULL, 0x567c3eebb8fda024ULL, 0xcff783a48584b019ULL,
+  0x95e2c6ce20304456ULL, 0xbfee160817f4780fULL, 0x97ac00eb445ea151ULL, 0x6f1cd3c7378025a6ULL,
+  0x51a8efa3647f10b9ULL, 0xaf77416c1cae7171ULL, 0x1926169933a2c31dULL, 0x6bc4cfc877ab41f3ULL,
+  0x7afa4f27e7ea7ac5ULL, 0x558184c2fa872510ULL, 0x44ddd95d56b36b34ULL, 0xba9f36fbd7f4c31eULL,
+  0x82d10df2d0b53ac5ULL, 0xe57535f7d6410e90ULL, 0xf7eaf8629ca9c96aULL, 0xa194dcc9221139acULL,
+  0x956099c855412265ULL, 0x480b964528ad0899ULL, 0x9ad451a8fd82a820ULL, 0x9e275b573b3c8146ULL,
+  0xf7b6bb21f1619d8cULL, 0x55ce223933ac4b85ULL, 0x340a3d645290ab5dULL, 0x3e7d806eea5d6ca7ULL,
+  0xa78360d7f22cc48cULL, 0x7ee8c3222b19d083ULL, 0xb385a80f34b40f1eULL, 0x11f5819e9a3c45a2ULL,
+  0xc4b9b73163d23ebdULL, 0xaab62b67e1b440f0ULL, 0x9ac047a7439b79b6ULL, 0x5b248c002743b389ULL,
+  0x591fd4673b8215ebULL, 0x176577cb2315c91dULL, 0xf777c9880303e2deULL, 0xbfb0d9ede38df76fULL,
+  0xfbf6177ff3f2f734ULL, 0x5df7e312a2856409ULL, 0x426bee13b37c2a7aULL, 0xd9b74e1e8e538979ULL,
+  0xdf408bc137d7b283ULL, 0x968697f90010a42fULL, 0x2de99eb2648a28b8ULL, 0x6d4932e1f2814c15ULL,
+  0xf5b9c62b824d0e01ULL, 0x426388eb96d040e9ULL, 0xfd609cf00b7d5c42ULL, 0x10d72ab44995639cULL,
+  0xc22fb2ee3c9adce4ULL, 0x6c4c8a5c1c28fd16ULL, 0x97ac3a0de459d848ULL, 0x5e1310cd06ff6051ULL,
+  0xda0f0877f515fe5dULL, 0x83e1c944c0498e86ULL, 0x3566b9a185630f97ULL, 0x70286b2880de5ac0ULL,
+  0x383ef81727e65e21ULL, 0x74cf82b31797bed5ULL, 0xde5615f714819a03ULL, 0xd97471b444c2e53bULL,
+  0x20a2155bf4f7fb6aULL, 0x85cbd8a68b8d3548ULL, 0xc5b58eea8374d0b9ULL, 0xd63f0013988b064bULL,
+  0x1c572ea2f0f9abb8ULL, 0x3164f9ff62b0124aULL, 0xf68e8e7c4fedef4dULL, 0x2f15d9889e4036e2ULL,
+  0x4797036285bf7b19ULL, 0xb05db491e5f2ba6fULL, 0x10aa771bff80bc4eULL, 0x16adb0381d232671ULL,
+  0x6d1a3c681dd8c301ULL, 0x5484fe7ac343ece4ULL, 0x803eb201808ec5eaULL, 0x525245f5ce93df49ULL,
+  0x3ff1a457a5ac5c13ULL, 0xb0b7ce406f567d94ULL, 0xcc8c565c4be07665ULL, 0xc2d5fb90769d7dccULL,
+  0xf96dba1a4e5d2ab6ULL, 0xc86a0480a2ab0352ULL, 0x5bea7c92ec7ffa3bULL, 0x2efa4e089421d03bULL,
+  0x3221bc3933b0c478ULL, 0xd3575a21ca932b98ULL, 0x9f9a52467c1b800fULL, 0xa7f70488eda87118ULL,
+  0x1c6fd33ad6f2c1d5ULL, 0xa88b79527e687a83ULL, 0xc77ef12464d72ee4ULL, 0xaff42e250391cda0ULL,
+  0x24ac23f5beb3ce08ULL, 0x36cffcd4323d3b06ULL, 0x3693b023b07235ddULL, 0x69b80baa18b27af0ULL,
+  0x55f9c03d23064157ULL, 0xc1fa0e6b45d2e570ULL, 0x1a5d808cf2c57738ULL, 0xae4728604eb8b4ccULL,
+  0xbc4bcae2447bf934ULL, 0x9b91d9fddae9abf7ULL, 0xb8cdd319942e4358ULL, 0x1afb0fc004a13ca6ULL,
+  0xad2f5dc1fdd3ceb6ULL, 0xce8537033997f80aULL, 0x67f068b980a11043ULL, 0x29b51e3d66b9c928ULL,
+  0x53bb3a6216d3e3daULL, 0x638d838d693a9f7aULL, 0x1ec611418d04e03dULL, 0x7e6491bfa4c5c232ULL,
+  0x20d0b5e4a0d8c197ULL, 0x134579144ef5d3f4ULL, 0xdba33efd37911bfdULL, 0xc3ae2b20df183af5ULL,
+  0xaadd45a6a1bf06ebULL, 0x7a2fdc74a49f31deULL, 0xb4534318e6576af9ULL, 0x97ce62f044f2b22fULL,
+  0xe76e29694a9ad4baULL, 0x6a3359d1c2fc61f1ULL, 0x1e27efc0082d862cULL, 0x3a8e6e6a11a6cabcULL,
+  0x34efd1b3cd4547bfULL, 0xa6510984e40d278cULL, 0xc0692cc98df19bbdULL, 0x347822a4f496a2b1ULL,
+  0xbec7fb143c82637cULL, 0x662c1e3ac0ce1680ULL, 0x4e4b6c8ed45f22fcULL, 0xdcb78efe13bf05f8ULL,
+  0xa120615de3ad37daULL, 0x370545d991e091b5ULL, 0x7d3e6bf85a48ab38ULL, 0xa1ed8fdb29e64139ULL,
+  0xdca14f99955ce52aULL, 0x90424dbd516bbabdULL, 0x5ea28c1ab5218225ULL, 0x6711d61210d3b866ULL,
+  0x290893b5120015bcULL, 0x2b782e8263024b93ULL, 0x4aa13b96504424caULL, 0x71fb9d38a790c104ULL,
+  0x1f410d7b3ea3a9c7ULL, 0xc98bbce010106532ULL, 0x687314c24a176055ULL, 0x441235b82ab586b6ULL,
+  0x2515d6a11b7fec06ULL, 0xed9151cfc876fd54ULL, 0x6861dd441e4c0e6dULL, 0x81044a2a944ffd71ULL,
+  0x2a4a309b2a4e7ef9ULL, 0x3d7c72a847624a69ULL, 0x60c2f29e96377d26ULL, 0x46027af2de20d88cULL,
+  0xba8ae4225538daf7ULL, 0x724904555575cefdULL, 0x4f1df0bc55c26f2aULL, 0xfb649472b36d9e5cULL,
+  0x57ddabfc0bb2a684ULL, 0x96444a0b1729f0beULL, 0xb5c4463462e713f0ULL, 0xa736f3f9d680000aULL,
+  0xe574283f2b61c52fULL, 0x42e956ff69463e34ULL, 0x22af9b6787b4d4b3ULL, 0xf65c043cf959b332ULL,
+  0xc626e053a9800a29ULL, 0x8480ecedff6c1b0bULL, 0xeafdf4853cf60a5eULL, 0xe917ee5e21742192ULL,
+  0x519ffa62ec5dda22ULL, 0xc9ccdcad7c366dbcULL, 0xa242065f92dd2cbdULL, 0x5a94012b14565dc3ULL,
+  0xe705a9a50f016db1ULL, 0x9fe480ff0da3620bULL, 0x3148e7af8f874e59ULL, 0xed6eddbf224baa63ULL,
+  0x29e20050670d1bb0ULL, 0x574b11942bcaef29ULL, 0xd745da51dd766f20ULL, 0x4f414a5cdffe4997ULL,
+  0xd0e90d0c651a2044ULL, 0xd9eddf22cee99df4ULL, 0x93327c2066096cbcULL, 0xf5a239402e402eceULL,
+  0xfebe85a6b15c4510ULL, 0x91ce18c35e92bb6aULL, 0xad680e0c8c58c0d1ULL, 0x393b9566ccd119e8ULL,
+  0x8e783a4890220b23ULL, 0xa1149667efdbe962ULL, 0x741801949ed6fa2bULL, 0x37d29244e37d752fULL,
+  0x3567c21dd8b1ef73ULL, 0x90933e48717c96e6ULL, 0x780417f0957f4ee2ULL, 0x2f558b0698e48a92ULL,
+  0xb842532de87a9353ULL, 0xa61ae4a6544d6c76ULL, 0xb558f290c4c98421ULL, 0xbfed3b947c6b5fd3ULL,
+  0x6b4c3acc9465c494ULL, 0x5b147e3a0e64830bULL, 0x56879607180a0a1bULL, 0x31bb80f66be9730cULL,
+  0xf42dd2afaa6a8798ULL, 0x1d2c22d6a35c283cULL, 0x7997561cad211bebULL, 0xf20441d81d391784ULL,
+  0x5dc8214322ad3f5bULL, 0xfd3a4c4c20dd6097ULL, 0xc8d7706ec4ff1e34ULL, 0x592ca8ebc4560451ULL,
+  0xedd9425ae24bbe2bULL, 0xdbbd4db5c05469fbULL, 0xc3a09553bbc7bd55ULL, 0x162cd732be1d85ecULL,
+  0x813deed02421744cULL, 0x276c5f5edd3d0a29ULL, 0xc4fbcedc7d5e2190ULL, 0x58dca9addf887219ULL,
+  0xd9370bfb5ca4806bULL, 0x2eebce5c3643f37eULL, 0x6fd4778ba7521f05ULL, 0x4d66738bd6e66243ULL,
+  0xa13da4c4da534704ULL, 0xb8b87cc88e28314fULL, 0xab5be3456e629915ULL, 0x795ac63d42915267ULL,
+  0xe942d579d165e850ULL, 0x475a17d747641a65ULL, 0x8349f0970e69907fULL, 0xaf70339be42543d0ULL,
+  0x93a00c0dc47229ddULL, 0xc7eb0719635a10deULL, 0x12d6f4f2b9ecb973ULL, 0x9a827981b01095c2ULL,
+  0xbb2bd772876000b4ULL, 0x90b33727a4e2a866ULL, 0xe3f7e963cbc5b42eULL, 0xcbc075d283560133ULL,
+  0x8aded3612dabefe1ULL, 0x8511cba5e769e316ULL, 0x2bbd767d4daa7189ULL, 0x79c8b17f9f1b12d3ULL,
+  0x7498a895ac87056fULL, 0x73ff178d3bf48436ULL, 0x94f96b8e6b3f6c55ULL, 0x925082b0ced3191bULL,
+  0x54172999be82a622ULL, 0xd1cc722dc3ec4932ULL, 0xf63e5cc683eaedb4ULL, 0x44fe5045baffd54bULL,
+  0x81708eb9f826602dULL, 0xbfa4c19169b0e477ULL, 0x399f568fb00c7836ULL, 0x76379a5b024e359cULL,
+  0xfec86ecc435e1bc7ULL
+};
+
+//side to move key, present when white is to move
+constexpr uint64 ZOBRIST_WHITE_TO_MOVE_KEY = 0x9b95ae2878a84dd6ULL;
+
+template <size_t SZ>
+uint64 zobrist_hash(Player player, Pt pt){
+  static_assert(SZ <= ZOBRIST_MAX_SIZE, "no zobrist keys for board size");
+  assert(player == Player::Black || player == Player::White);
+
+  return ZOBRIST_STONE_KEYS[(uint)player - 1][index<SZ>(pt)];
+}
+
 template <size_t SZ>
-uint zobrist_hash(Player player, Pt pt){
-  assert(player != Player::Unknown);
+uint64 zobrist_ko_hash(Pt pt){
+  static_assert(SZ <= ZOBRIST_MAX_SIZE, "no zobrist keys for board size");
+
+  return ZOBRIST_KO_KEYS[index<SZ>(pt)];
+}
 
-  uint key = index<SZ>(pt);
-  key |= (uint)player << 16;
-  switch (key){
-    case 0x10000U: return 0xaafddfa0U; break;
-    case 0x10001U: return 0x23795f46U; break;
-    case 0x10002U: return 0x7cc28ba1U; break;
-    case 0x10003U: return 0xee828049U; break;
-    case 0x10004U: return 0xa5e27d46U; break;
-    case 0x10005U: return 0xc8816c1cU; break;
-    case 0x10006U: return 0x6dae8f17U; break;
-    case 0x10007U: return 0xf822c272U; break;
-    case 0x10008U: return 0xe4483481U; break;
-    case 0x10009U: return 0xf54d6e58U; break;
-    case 0x1000aU: return 0x764abb8fU; break;
-    case 0x1000bU: return 0x22adbe0dU; break;
-    case 0x1000cU: return 0xc4c81200U; break;
-    case 0x1000dU: return 0x59e0fbdeU; break;
-    case 0x1000eU: return 0x9bff6892U; break;
-    case 0x1000fU: return 0x774537dfU; break;
-    case 0x10010U: return 0xb9a7d820U; break;
-    case 0x10011U: return 0xb0b719c0U; break;
-    case 0x10012U: return 0x958512f8U; break;
-    case 0x10013U: return 0xf71f9badU; break;
-    case 0x10014U: return 0x1937f9eaU; break;
-    case 0x10015U: return 0x87f9f14bU; break;
-    case 0x10016U: return 0x28476bd3U; break;
-    case 0x10017U: return 0x34cc54f0U; break;
-    case 0x10018U: return 0x95e7b20cU; break;
-    case 0x10019U: return 0x66c6de75U; break;
-    case 0x1001aU: return 0x31ac4155U; break;
-    case 0x1001bU: return 0x4c48e19eU; break;
-    case 0x1001cU: return 0xe6926e7bU; break;
-    case 0x1001dU: return 0x8599c31aU; break;
-    case 0x1001eU: return 0xf3fed604U; break;
-    case 0x1001fU: return 0xd666496eU; break;
-    case 0x10020U: return 0x4e83bf77U; break;
-    case 0x10021U: return 0x59f188f3U; break;
-    case 0x10022U: return 0x2b1b28afU; break;
-    case 0x10023U: return 0x4279f0a8U; break;
-    case 0x10024U: return 0xf93b9247U; break;
-    case 0x10025U: return 0x97ed0dfeU; break;
-    case 0x10026U: return 0x9de3f876U; break;
-    case 0x10027U: return 0x90e2127eU; break;
-    case 0x10028U: return 0xa4f8621dU; break;
-    case 0x10029U: return 0x1d91c54fU; break;
-    case 0x1002aU: return 0xcf97ceecU; break;
-    case 0x1002bU: return 0x46f35df2U; break;
-    case 0x1002cU: return 0x2ec0e3afU; break;
-    case 0x1002dU: return 0x1057cdcbU; break;
-    case 0x1002eU: return 0x8fdc81b8U; break;
-    case 0x1002fU: return 0xf57198e6U; break;
-    case 0x10030U: return 0x3cb3b917U; break;
-    case 0x10031U: return 0x9d11f7c7U; break;
-    case 0x10032U: return 0x34a22831U; break;
-    case 0x10033U: return 0x8860c010U; break;
-    case 0x10034U: return 0x7ca43b31U; break;
-    case 0x10035U: return 0x361b6a11U; break;
-    case 0x10036U: return 0xf5e62392U; break;
-    case 0x10037U: return 0xbdac9164U; break;
-    case 0x10038U: return 0x2a823baeU; break;
-    case 0x10039U: return 0xdde67b22U; break;
-    case 0x1003aU: return 0xe90d806bU; break;
-    case 0x1003bU: return 0x3c798f2fU; break;
-    case 0x1003cU: return 0xb0da4dc9U; break;
-    case 0x1003dU: return 0xbffdbaddU; break;
-    case 0x1003eU: return 0x77c3b688U; break;
-    case 0x1003fU: return 0xcac602c4U; break;
-    case 0x10040U: return 0x8b1ed1cbU; break;
-    case 0x10041U: return 0x2445a37dU; break;
-    case 0x10042U: return 0xfa9817cdU; break;
-    case 0x10043U: return 0x5478f526U; break;
-    case 0x10044U: return 0xd505581aU; break;
-    case 0x10045U: return 0xc150b505U; break;
-    case 0x10046U: return 0x212adcccU; break;
-    case 0x10047U: return 0x55006626U; break;
-    case 0x10048U: return 0x7a3289ebU; break;
-    case 0x10049U: return 0x16135dceU; break;
-    case 0x1004aU: return 0xb3b7766bU; break;
-    case 0x1004bU: return 0xa5321f85U; break;
-    case 0x1004cU: return 0x3dce3c87U; break;
-    case 0x1004dU: return 0x88943d7cU; break;
-    case 0x1004eU: return 0xefd68bb6U; break;
-    case 0x1004fU: return 0xcde2ab70U; break;
-    case 0x10050U: return 0xb7815e24U; break;
-    case 0x10051U: return 0x39eac2f5U; break;
-    case 0x10052U: return 0x9554c5bdU; break;
-    case 0x10053U: return 0x18cf2ea6U; break;
-    case 0x10054U: return 0xbc5f6579U; break;
-    case 0x10055U: return 0x8e4ad256U; break;
-    case 0x10056U: return 0xbd6e736eU; break;
-    case 0x10057U: return 0x71921f62U; break;
-    case 0x10058U: return 0xff438b56U; break;
-    case 0x10059U: return 0x3731025cU; break;
-    case 0x1005aU: return 0x5e9203d3U; break;
-    case 0x1005bU: return 0x99e16358U; break;
-    case 0x1005cU: return 0x2d0fdc74U; break;
-    case 0x1005dU: return 0xa181ab97U; break;
-    case 0x1005eU: return 0xc33ae409U; break;
-    case 0x1005fU: return 0x46551f71U; break;
-    case 0x10060U: return 0x6fb40194U; break;
-    case 0x10061U: return 0x1ff5ec7bU; break;
-    case 0x10062U: return 0xbfd92cc9U; break;
-    case 0x10063U: return 0x11e8ff69U; break;
-    case 0x10064U: return 0xc912c920U; break;
-    case 0x10065U: return 0x670526c6U; break;
-    case 0x10066U: return 0x8c6ee0ddU; break;
-    case 0x10067U: return 0xbd461bc3U; break;
-    case 0x10068U: return 0xaec38aebU; break;
-    case 0x10069U: return 0x5a8fa481U; break;
-    case 0x1006aU: return 0x7afa116dU; break;
-    case 0x1006bU: return 0xed63a210U; break;
-    case 0x1006cU: return 0x45aea3b8U; break;
-    case 0x1006dU: return 0x9e35b84fU; break;
-    case 0x1006eU: return 0xd2bf9894U; break;
-    case 0x1006fU: return 0x55f28648U; break;
-    case 0x10070U: return 0x35f6572fU; break;
-    case 0x10071U: return 0x6cd9df53U; break;
-    case 0x10072U: return 0xd222e8feU; break;
-    case 0x10073U: return 0x1b30a1e2U; break;
-    case 0x10074U: return 0x22b0a364U; break;
-    case 0x10075U: return 0x1632106dU; break;
-    case 0x10076U: return 0xd99f0426U; break;
-    case 0x10077U: return 0xf9994cdcU; break;
-    case 0x10078U: return 0xf509ca74U; break;
-    case 0x10079U: return 0xa2dae438U; break;
-    case 0x1007aU: return 0xe39324b3U; break;
-    case 0x1007bU: return 0xaef91067U; break;
-    case 0x1007cU: return 0x7ec853f5U; break;
-    case 0x1007dU: return 0x5bd33b03U; break;
-    case 0x1007eU: return 0x6c8ac634U; break;
-    case 0x1007fU: return 0x2c06d54bU; break;
-    case 0x10080U: return 0x8ff9c788U; break;
-    case 0x10081U: return 0x1ce45a41U; break;
-    case 0x10082U: return 0x2c459bdaU; break;
-    case 0x10083U: return 0x6fa15c0aU; break;
-    case 0x10084U: return 0xd3885da8U; break;
-    case 0x10085U: return 0x8e6cfec4U; break;
-    case 0x10086U: return 0x1fa3b1beU; break;
-    case 0x10087U: return 0xe7183de4U; break;
-    case 0x10088U: return 0xc66768d3U; break;
-    case 0x10089U: return 0x3f262880U; break;
-    case 0x1008aU: return 0x88fdabf3U; break;
-    case 0x1008bU: return 0xfda65e01U; break;
-    case 0x1008cU: return 0xe0afba24U; break;
-    case 0x1008dU: return 0xecd216ebU; break;
-    case 0x1008eU: return 0xa2231ee5U; break;
-    case 0x1008fU: return 0x70636755U; break;
-    case 0x10090U: return 0x218f8373U; break;
-    case 0x10091U: return 0xc12a5ca5U; break;
-    case 0x10092U: return 0xecc6df30U; break;
-    case 0x10093U: return 0x469fd01eU; break;
-    case 0x10094U: return 0x22b35989U; break;
-    case 0x10095U: return 0x48f24690U; break;
-    case 0x10096U: return 0x24c4e099U; break;
-    case 0x10097U: return 0x1bb1b3c4U; break;
-    case 0x10098U: return 0x6d3ca767U; break;
-    case 0x10099U: return 0x113aca2bU; break;
-    case 0x1009aU: return 0x4b17b38bU; break;
-    case 0x1009bU: return 0x6ecb9c12U; break;
-    case 0x1009cU: return 0x23645774U; break;
-    case 0x1009dU: return 0x7ba1d6c2U; break;
-    case 0x1009eU: return 0xd32dba8bU; break;
-    case 0x1009fU: return 0xeb7500ddU; break;
-    case 0x100a0U: return 0xf2a044b3U; break;
-    case 0x100a1U: return 0x158f0549U; break;
-    case 0x100a2U: return 0xbf6decfcU; break;
-    case 0x100a3U: return 0xb195014bU; break;
-    case 0x100a4U: return 0x6b30bb2bU; break;
-    case 0x100a5U: return 0xb60ee345U; break;
-    case 0x100a6U: return 0x46b3d59aU; break;
-    case 0x100a7U: return 0x94753d75U; break;
-    case 0x100a8U: return 0x35322bb6U; break;
-    case 0x100a9U: return 0x720123beU; break;
-    case 0x100aaU: return 0x73ba184eU; break;
-    case 0x100abU: return 0xeadaf472U; break;
-    case 0x100acU: return 0xe9441297U; break;
-    case 0x100adU: return 0x3dc65036U; break;
-    case 0x100aeU: return 0x19dd606fU; break;
-    case 0x100afU: return 0x202d5825U; break;
-    case 0x100b0U: return 0x228d560cU; break;
-    case 0x100b1U: return 0xcddbabd2U; break;
-    case 0x100b2U: return 0x8cec02bdU; break;
-    case 0x100b3U: return 0xde10354dU; break;
-    case 0x100b4U: return 0x547afe04U; break;
-    case 0x100b5U: return 0x9686419cU; break;
-    case 0x100b6U: return 0xeb078056U; break;
-    case 0x100b7U: return 0xdb834846U; break;
-    case 0x100b8U: return 0x6bec6203U; break;
-    case 0x100b9U: return 0xe32c9389U; break;
-    case 0x100baU: return 0x185d6610U; break;
-    case 0x100bbU: return 0x7c5c9cc2U; break;
-    case 0x100bcU: return 0x57f6b1e6U; break;
-    case 0x100bdU: return 0x641d1847U; break;
-    case 0x100beU: return 0xae24962eU; break;
-    case 0x100bfU: return 0xdb6583f0U; break;
-    case 0x100c0U: return 0x918326afU; break;
-    case 0x100c1U: return 0xac3aae5cU; break;
-    case 0x100c2U: return 0xa5e04253U; break;
-    case 0x100c3U: return 0x4dea9441U; break;
-    case 0x100c4U: return 0x96bd795aU; break;
-    case 0x100c5U: return 0x1a7f4999U; break;
-    case 0x100c6U: return 0x709ea8d0U; break;
-    case 0x100c7U: return 0xb307d198U; break;
-    case 0x100c8U: return 0xbc070c4fU; break;
-    case 0x100c9U: return 0x8dc3bec9U; break;
-    case 0x100caU: return 0x7be7552eU; break;
-    case 0x100cbU: return 0x418f5a56U; break;
-    case 0x100ccU: return 0x2daa9faeU; break;
-    case 0x100cdU: return 0x15fef4a0U; break;
-    case 0x100ceU: return 0x87d0ad27U; break;
-    case 0x100cfU: return 0x71e0b059U; break;
-    case 0x100d0U: return 0xb4964f7bU; break;
-    case 0x100d1U: return 0x67a767b2U; break;
-    case 0x100d2U: return 0x6d40ceb6U; break;
-    case 0x100d3U: return 0xd2163d65U; break;
-    case 0x100d4U: return 0xae7ac22fU; break;
-    case 0x100d5U: return 0x8b5e809cU; break;
-    case 0x100d6U: return 0x751ec763U; break;
-    case 0x100d7U: return 0xb60b7413U; break;
-    case 0x100d8U: return 0x687a5fe2U; break;
-    case 0x100d9U: return 0xf8531402U; break;
-    case 0x100daU: return 0x32a5f824U; break;
-    case 0x100dbU: return 0x8bf3b947U; break;
-    case 0x100dcU: return 0x6ae9a87dU; break;
-    case 0x100ddU: return 0x5b6d882fU; break;
-    case 0x100deU: return 0x45040410U; break;
-    case 0x100dfU: return 0x5ee2e9a2U; break;
-    case 0x100e0U: return 0x452f4558U; break;
-    case 0x100e1U: return 0x669b5ef8U; break;
-    case 0x100e2U: return 0xcb5331e9U; break;
-    case 0x100e3U: return 0xc5b727cfU; break;
-    case 0x100e4U: return 0x110edc9eU; break;
-    case 0x100e5U: return 0xca075895U; break;
-    case 0x100e6U: return 0x71aee12aU; break;
-    case 0x100e7U: return 0x1b7110fbU; break;
-    case 0x100e8U: return 0x67735da7U; break;
-    case 0x100e9U: return 0xdcc403ffU; break;
-    case 0x100eaU: return 0xc135356fU; break;
-    case 0x100ebU: return 0x44f8269dU; break;
-    case 0x100ecU: return 0x5567d2d5U; break;
-    case 0x100edU: return 0x14871b5aU; break;
-    case 0x100eeU: return 0xfe0dd60aU; break;
-    case 0x100efU: return 0x9add60cbU; break;
-    case 0x100f0U: return 0xbff8a923U; break;
-    case 0x100f1U: return 0xdb7d37b9U; break;
-    case 0x100f2U: return 0x60980f0eU; break;
-    case 0x100f3U: return 0x73b37855U; break;
-    case 0x100f4U: return 0x1a3911f6U; break;
-    case 0x100f5U: return 0x139e1de4U; break;
-    case 0x100f6U: return 0x1887d855U; break;
-    case 0x100f7U: return 0x17e9670bU; break;
-    case 0x100f8U: return 0xc9252507U; break;
-    case 0x100f9U: return 0x643c6b74U; break;
-    case 0x100faU: return 0xbc1c345eU; break;
-    case 0x100fbU: return 0xd94ea351U; break;
-    case 0x100fcU: return 0xb5e54fb6U; break;
-    case 0x100fdU: return 0xea920df1U; break;
-    case 0x100feU: return 0x608a4255U; break;
-    case 0x100ffU: return 0x13ac037dU; break;
-    case 0x10100U: return 0x49897b53U; break;
-    case 0x10101U: return 0xc0279dd4U; break;
-    case 0x10102U: return 0xc71dd987U; break;
-    case 0x10103U: return 0x36ff0963U; break;
-    case 0x10104U: return 0x2cf1a4a8U; break;
-    case 0x10105U: return 0x47def300U; break;
-    case 0x10106U: return 0x66205ec8U; break;
-    case 0x10107U: return 0xd14cf6d6U; break;
-    case 0x10108U: return 0x6b5e75e1U; break;
-    case 0x10109U: return 0x3192e87dU; break;
-    case 0x1010aU: return 0x31b7f8bfU; break;
-    case 0x1010bU: return 0x717c1af1U; break;
-    case 0x1010cU: return 0x270edd90U; break;
-    case 0x1010dU: return 0xed6fe2a8U; break;
-    case 0x1010eU: return 0x96eb7f63U; break;
-    case 0x1010fU: return 0xcebd0fd8U; break;
-    case 0x10110U: return 0xeee62e1dU; break;
-    case 0x10111U: return 0xa8604669U; break;
-    case 0x10112U: return 0xf41398a5U; break;
-    case 0x10113U: return 0xe0a2b812U; break;
-    case 0x10114U: return 0x930d59f2U; break;
-    case 0x10115U: return 0xf927f89aU; break;
-    case 0x10116U: return 0x4e079c1fU; break;
-    case 0x10117U: return 0xb971feeaU; break;
-    case 0x10118U: return 0xd7a44ca3U; break;
-    case 0x10119U: return 0xb73a3585U; break;
-    case 0x1011aU: return 0xf2c62317U; break;
-    case 0x1011bU: return 0x7535049aU; break;
-    case 0x1011cU: return 0xf0d677b9U; break;
-    case 0x1011dU: return 0x34ec321aU; break;
-    case 0x1011eU: return 0x6d229b91U; break;
-    case 0x1011fU: return 0x4d1fbca2U; break;
-    case 0x10120U: return 0xb3e9c839U; break;
-    case 0x10121U: return 0xfd546ce4U; break;
-    case 0x10122U: return 0xa4a2648fU; break;
-    case 0x10123U: return 0x7c6c9703U; break;
-    case 0x10124U: return 0xc80c1d1bU; break;
-    case 0x10125U: return 0x507386f0U; break;
-    case 0x10126U: return 0xcf44f28fU; break;
-    case 0x10127U: return 0xad3bf229U; break;
-    case 0x10128U: return 0xdeed5f5dU; break;
-    case 0x10129U: return 0xe9b44e7cU; break;
-    case 0x1012aU: return 0xf67d581dU; break;
-    case 0x1012bU: return 0x2a3269e4U; break;
-    case 0x1012cU: return 0xfe53b827U; break;
-    case 0x1012dU: return 0x86290153U; break;
-    case 0x1012eU: return 0x8d5fdd97U; break;
-    case 0x1012fU: return 0x1d01ddccU; break;
-    case 0x10130U: return 0xf61640cfU; break;
-    case 0x10131U: return 0x129c3e02U; break;
-    case 0x10132U: return 0xf1fcf4fbU; break;
-    case 0x10133U: return 0x57dbcdc5U; break;
-    case 0x10134U: return 0x6f8351b0U; break;
-    case 0x10135U: return 0x21a8475eU; break;
-    case 0x10136U: return 0x6b534cd2U; break;
-    case 0x10137U: return 0x5d38638eU; break;
-    case 0x10138U: return 0x3c5669e5U; break;
-    case 0x10139U: return 0xcd70cfa3U; break;
-    case 0x1013aU: return 0x7318061fU; break;
-    case 0x1013bU: return 0x76c9deaeU; break;
-    case 0x1013cU: return 0xb44d8d67U; break;
-    case 0x1013dU: return 0xaa6e98d4U; break;
-    case 0x1013eU: return 0xb7f2a892U; break;
-    case 0x1013fU: return 0x6771a76dU; break;
-    case 0x10140U: return 0x315fceefU; break;
-    case 0x10141U: return 0x31180559U; break;
-    case 0x10142U: return 0x4669d1caU; break;
-    case 0x10143U: return 0xda00ca4aU; break;
-    case 0x10144U: return 0xdeadd929U; break;
-    case 0x10145U: return 0xd9fed470U; break;
-    case 0x10146U: return 0xc6e5c0ecU; break;
-    case 0x10147U: return 0x8b036081U; break;
-    case 0x10148U: return 0x7ee59cbbU; break;
-    case 0x10149U: return 0x4f697385U; break;
-    case 0x1014aU: return 0x20cd6d16U; break;
-    case 0x1014bU: return 0x8f8ab577U; break;
-    case 0x1014cU: return 0xd1c8d346U; break;
-    case 0x1014dU: return 0xb59aa62bU; break;
-    case 0x1014eU: return 0xcfa321efU; break;
-    case 0x1014fU: return 0xf6eeaf17U; break;
-    case 0x10150U: return 0x97a4d7cdU; break;
-    case 0x10151U: return 0x44baa9bcU; break;
-    case 0x10152U: return 0xb91c327dU; break;
-    case 0x10153U: return 0xe364dedfU; break;
-    case 0x10154U: return 0x685935a8U; break;
-    case 0x10155U: return 0xe908d29fU; break;
-    case 0x10156U: return 0xa0291c93U; break;
-    case 0x10157U: return 0xdeb214f2U; break;
-    case 0x10158U: return 0x5d8d353aU; break;
-    case 0x10159U: return 0xc983ecfaU; break;
-    case 0x1015aU: return 0x8bf22cd7U; break;
-    case 0x1015bU: return 0xaa02dee6U; break;
-    case 0x1015cU: return 0x1d6687fcU; break;
-    case 0x1015dU: return 0xe79695c0U; break;
-    case 0x1015eU: return 0xb6c4d51aU; break;
-    case 0x1015fU: return 0xa2ecafdcU; break;
-    case 0x10160U: return 0xf7915954U; break;
-    case 0x10161U: return 0xaa6c52c1U; break;
-    case 0x10162U: return 0x6e0c1620U; break;
-    case 0x10163U: return 0xf2593955U; break;
-    case 0x10164U: return 0xd97cad75U; break;
-    case 0x10165U: return 0x89a711eeU; break;
-    case 0x10166U: return 0xee228590U; break;
-    case 0x10167U: return 0x6606eb24U; break;
-    case 0x10168U: return 0xcac62091U; break;
-    case 0x20000U: return 0x4b5955b4U; break;
-    case 0x20001U: return 0xa9a130c8U; break;
-    case 0x20002U: return 0x32ddf87eU; break;
-    case 0x20003U: return 0x5c03cfc7U; break;
-    case 0x20004U: return 0x37d99ea0U; break;
-    case 0x20005U: return 0x91a2b591U; break;
-    case 0x20006U: return 0x5f98c4caU; break;
-    case 0x20007U: return 0x579191c3U; break;
-    case 0x20008U: return 0x8e529c0fU; break;
-    case 0x20009U: return 0xb91e4ad7U; break;
-    case 0x2000aU: return 0x5a1e7628U; break;
-    case 0x2000bU: return 0x1d78626cU; break;
-    case 0x2000cU: return 0x9d84f260U; break;
-    case 0x2000dU: return 0x399bdbfdU; break;
-    case 0x2000eU: return 0x575ec559U; break;
-    case 0x2000fU: return 0x5b8d79b3U; break;
-    case 0x20010U: return 0x442a7cfbU; break;
-    case 0x20011U: return 0xaaed5b01U; break;
-    case 0x20012U: return 0xe962c214U; break;
-    case 0x20013U: return 0xd0ede02cU; break;
-    case 0x20014U: return 0xf48f19daU; break;
-    case 0x20015U: return 0xa28b9bd3U; break;
-    case 0x20016U: return 0x4e10ade2U; break;
-    case 0x20017U: return 0x590516e5U; break;
-    case 0x20018U: return 0x3604203eU; break;
-    case 0x20019U: return 0xb2dac5bbU; break;
-    case 0x2001aU: return 0xa22ae262U; break;
-    case 0x2001bU: return 0x747bc770U; break;
-    case 0x2001cU: return 0x24a33b7dU; break;
-    case 0x2001dU: return 0x97307f73U; break;
-    case 0x2001eU: return 0x3f1ed268U; break;
-    case 0x2001fU: return 0x61a8965fU; break;
-    case 0x20020U: return 0x60c50ea0U; break;
-    case 0x20021U: return 0x1409100aU; break;
-    case 0x20022U: return 0x7dddf644U; break;
-    case 0x20023U: return 0x83e2196bU; break;
-    case 0x20024U: return 0x71229d37U; break;
-    case 0x20025U: return 0x52cb97f7U; break;
-    case 0x20026U: return 0xa4317e98U; break;
-    case 0x20027U: return 0x518149c9U; break;
-    case 0x20028U: return 0x5ce806b3U; break;
-    case 0x20029U: return 0x6c88cf9eU; break;
-    case 0x2002aU: return 0x36eb73f9U; break;
-    case 0x2002bU: return 0x2409646aU; break;
-    case 0x2002cU: return 0xb1ac7c33U; break;
-    case 0x2002dU: return 0x9117163bU; break;
-    case 0x2002eU: return 0x49beb23eU; break;
-    case 0x2002fU: return 0x192a8effU; break;
-    case 0x20030U: return 0xe0ab483cU; break;
-    case 0x20031U: return 0x2ee3b5d8U; break;
-    case 0x20032U: return 0xd30784eeU; break;
-    case 0x20033U: return 0x1879e0eeU; break;
-    case 0x20034U: return 0xa09a52c5U; break;
-    case 0x20035U: return 0x5d685247U; break;
-    case 0x20036U: return 0xe4385e1cU; break;
-    case 0x20037U: return 0xc761a1f5U; break;
-    case 0x20038U: return 0xbe348f6fU; break;
-    case 0x20039U: return 0xf0240c67U; break;
-    case 0x2003aU: return 0xca011ddeU; break;
-    case 0x2003bU: return 0x7d89531fU; break;
-    case 0x2003cU: return 0xd644ff88U; break;
-    case 0x2003dU: return 0xb04a4b80U; break;
-    case 0x2003eU: return 0x9ece18d5U; break;
-    case 0x2003fU: return 0xf828ddd2U; break;
-    case 0x20040U: return 0xae7c8786U; break;
-    case 0x20041U: return 0x5a793925U; break;
-    case 0x20042U: return 0xd2a134deU; break;
-    case 0x20043U: return 0x9c976c9dU; break;
-    case 0x20044U: return 0x88918328U; break;
-    case 0x20045U: return 0x4cd5bec9U; break;
-    case 0x20046U: return 0xe74ee95eU; break;
-    case 0x20047U: return 0xd4bbab9cU; break;
-    case 0x20048U: return 0xb9831589U; break;
-    case 0x20049U: return 0x9fc6ddc0U; break;
-    case 0x2004aU: return 0x7920f32eU; break;
-    case 0x2004bU: return 0xc63ba721U; break;
-    case 0x2004cU: return 0x2140ba7cU; break;
-    case 0x2004dU: return 0x2ef2d925U; break;
-    case 0x2004eU: return 0xa1a7302bU; break;
-    case 0x2004fU: return 0xb81538f6U; break;
-    case 0x20050U: return 0x504ec977U; break;
-    case 0x20051U: return 0xe6965479U; break;
-    case 0x20052U: return 0x8db5567eU; break;
-    case 0x20053U: return 0x4c02436dU; break;
-    case 0x20054U: return 0x57411e65U; break;
-    case 0x20055U: return 0x37d41f80U; break;
-    case 0x20056U: return 0x9cc0ab2bU; break;
-    case 0x20057U: return 0x324affb0U; break;
-    case 0x20058U: return 0xa90194c2U; break;
-    case 0x20059U: return 0x2629bc35U; break;
-    case 0x2005aU: return 0x19fcba57U; break;
-    case 0x2005bU: return 0x8003ab42U; break;
-    case 0x2005cU: return 0x40ff5731U; break;
-    case 0x2005dU: return 0x9460566bU; break;
-    case 0x2005eU: return 0xa2cda76dU; break;
-    case 0x2005fU: return 0xd5a32dd7U; break;
-    case 0x20060U: return 0x946680d4U; break;
-    case 0x20061U: return 0x91fe2de5U; break;
-    case 0x20062U: return 0xe6e2e301U; break;
-    case 0x20063U: return 0xd3cc6677U; break;
-    case 0x20064U: return 0x858b229bU; break;
-    case 0x20065U: return 0x7bb10becU; break;
-    case 0x20066U: return 0x64a84b30U; break;
-    case 0x20067U: return 0xd9909cddU; break;
-    case 0x20068U: return 0x419ba221U; break;
-    case 0x20069U: return 0xb531d14eU; break;
-    case 0x2006aU: return 0xebece1d2U; break;
-    case 0x2006bU: return 0x6950521cU; break;
-    case 0x2006cU: return 0x573564f9U; break;
-    case 0x2006dU: return 0x447e8e07U; break;
-    case 0x2006eU: return 0xe8e93307U; break;
-    case 0x2006fU: return 0x6f27459cU; break;
-    case 0x20070U: return 0x178044f9U; break;
-    case 0x20071U: return 0xf95a29ddU; break;
-    case 0x20072U: return 0x3a79c45cU; break;
-    case 0x20073U: return 0x1e733d3bU; break;
-    case 0x20074U: return 0x386ad474U; break;
-    case 0x20075U: return 0xbfd383e8U; break;
-    case 0x20076U: return 0xfebeea5bU; break;
-    case 0x20077U: return 0x6bf925f7U; break;
-    case 0x20078U: return 0xe1900219U; break;
-    case 0x20079U: return 0x2cee46efU; break;
-    case 0x2007aU: return 0x98d15c7cU; break;
-    case 0x2007bU: return 0x4d3cae55U; break;
-    case 0x2007cU: return 0x9991ae64U; break;
-    case 0x2007dU: return 0x4f04bebaU; break;
-    case 0x2007eU: return 0x9f49fcd3U; break;
-    case 0x2007fU: return 0xf4d657caU; break;
-    case 0x20080U: return 0x504ea9bfU; break;
-    case 0x20081U: return 0xdb78c415U; break;
-    case 0x20082U: return 0xef1b73c0U; break;
-    case 0x20083U: return 0x5296c4bbU; break;
-    case 0x20084U: return 0x266c184dU; break;
-    case 0x20085U: return 0x5d6b9782U; break;
-    case 0x20086U: return 0xb44e56c8U; break;
-    case 0x20087U: return 0x3fe241a4U; break;
-    case 0x20088U: return 0x1d199adbU; break;
-    case 0x20089U: return 0x67d1c14dU; break;
-    case 0x2008aU: return 0x4503d9b6U; break;
-    case 0x2008bU: return 0x4de6a156U; break;
-    case 0x2008cU: return 0xed8a0725U; break;
-    case 0x2008dU: return 0x6c4d9b62U; break;
-    case 0x2008eU: return 0xab29e5ddU; break;
-    case 0x2008fU: return 0xcd58db27U; break;
-    case 0x20090U: return 0x4f7b9ebcU; break;
-    case 0x20091U: return 0xdfaef5aaU; break;
-    case 0x20092U: return 0xf077b5c3U; break;
-    case 0x20093U: return 0xe01566abU; break;
-    case 0x20094U: return 0x8d65cb4aU; break;
-    case 0x20095U: return 0x5e13f8f1U; break;
-    case 0x20096U: return 0x5bc55c47U; break;
-    case 0x20097U: return 0x49dbac2aU; break;
-    case 0x20098U: return 0x705d1de7U; break;
-    case 0x20099U: return 0x6d0ca331U; break;
-    case 0x2009aU: return 0x9de8466fU; break;
-    case 0x2009bU: return 0x4cc074dcU; break;
-    case 0x2009cU: return 0xe463d262U; break;
-    case 0x2009dU: return 0xdb2bab1eU; break;
-    case 0x2009eU: return 0x605ad913U; break;
-    case 0x2009fU: return 0x29135fbeU; break;
-    case 0x200a0U: return 0x9935e87dU; break;
-    case 0x200a1U: return 0x4ea307edU; break;
-    case 0x200a2U: return 0x1f1eed20U; break;
-    case 0x200a3U: return 0x1969e25fU; break;
-    case 0x200a4U: return 0x2774da07U; break;
-    case 0x200a5U: return 0xe42ceeefU; break;
-    case 0x200a6U: return 0xe5ce458fU; break;
-    case 0x200a7U: return 0xe647f780U; break;
-    case 0x200a8U: return 0x3aaf174fU; break;
-    case 0x200a9U: return 0xec9a6599U; break;
-    case 0x200aaU: return 0x74f54954U; break;
-    case 0x200abU: return 0x57dcecc2U; break;
-    case 0x200acU: return 0xe914f59bU; break;
-    case 0x200adU: return 0xea2cbc7eU; break;
-    case 0x200aeU: return 0x46853351U; break;
-    case 0x200afU: return 0x9ebdca66U; break;
-    case 0x200b0U: return 0xb63dbc3bU; break;
-    case 0x200b1U: return 0x4d9ffab7U; break;
-    case 0x200b2U: return 0xf053da63U; break;
-    case 0x200b3U: return 0x3c5b69deU; break;
-    case 0x200b4U: return 0x7e4adb6bU; break;
-    case 0x200b5U: return 0x94f8fc07U; break;
-    case 0x200b6U: return 0xf882fb77U; break;
-    case 0x200b7U: return 0xfa78271aU; break;
-    case 0x200b8U: return 0x94389b16U; break;
-    case 0x200b9U: return 0x13e1d080U; break;
-    case 0x200baU: return 0xbd2b3cd0U; break;
-    case 0x200bbU: return 0xefcf1150U; break;
-    case 0x200bcU: return 0x63d8599bU; break;
-    case 0x200bdU: return 0x36691360U; break;
-    case 0x200beU: return 0x4f72a418U; break;
-    case 0x200bfU: return 0x2546c898U; break;
-    case 0x200c0U: return 0xe3c7f73cU; break;
-    case 0x200c1U: return 0xe6f34019U; break;
-    case 0x200c2U: return 0xea5da115U; break;
-    case 0x200c3U: return 0x8e9709dfU; break;
-    case 0x200c4U: return 0xc653cbe8U; break;
-    case 0x200c5U: return 0x5ead9cd4U; break;
-    case 0x200c6U: return 0xeb604899U; break;
-    case 0x200c7U: return 0x6484aafbU; break;
-    case 0x200c8U: return 0xe9681951U; break;
-    case 0x200c9U: return 0xc8b78671U; break;
-    case 0x200caU: return 0x35a9b8f4U; break;
-    case 0x200cbU: return 0x6a70e0dbU; break;
-    case 0x200ccU: return 0x8b030193U; break;
-    case 0x200cdU: return 0x2e164631U; break;
-    case 0x200ceU: return 0xc0a08cedU; break;
-    case 0x200cfU: return 0xacefe6e0U; break;
-    case 0x200d0U: return 0xddb834f5U; break;
-    case 0x200d1U: return 0xc7f327d6U; break;
-    case 0x200d2U: return 0x39b1b68dU; break;
-    case 0x200d3U: return 0x93d906cdU; break;
-    case 0x200d4U: return 0x8d3c1b45U; break;
-    case 0x200d5U: return 0xd0c0a674U; break;
-    case 0x200d6U: return 0x4b1220bcU; break;
-    case 0x200d7U: return 0x7d3ec585U; break;
-    case 0x200d8U: return 0x2d3aff16U; break;
-    case 0x200d9U: return 0x2367a6a1U; break;
-    case 0x200daU: return 0xbe4e018dU; break;
-    case 0x200dbU: return 0x2841587eU; break;
-    case 0x200dcU: return 0xa0ebd907U; break;
-    case 0x200ddU: return 0xfdc963a1U; break;
-    case 0x200deU: return 0xa4b2e116U; break;
-    case 0x200dfU: return 0xd1049341U; break;
-    case 0x200e0U: return 0x32116f02U; break;
-    case 0x200e1U: return 0x168d6288U; break;
-    case 0x200e2U: return 0x32cf70aeU; break;
-    case 0x200e3U: return 0xfbaeeba9U; break;
-    case 0x200e4U: return 0x6102ec68U; break;
-    case 0x200e5U: return 0x37be4c96U; break;
-    case 0x200e6U: return 0x12f49e2eU; break;
-    case 0x200e7U: return 0x6fcd1658U; break;
-    case 0x200e8U: return 0x82222d91U; break;
-    case 0x200e9U: return 0x878f45d5U; break;
-    case 0x200eaU: return 0xe4513dc4U; break;
-    case 0x200ebU: return 0x77eb84b5U; break;
-    case 0x200ecU: return 0x1e988988U; break;
-    case 0x200edU: return 0xe73402e5U; break;
-    case 0x200eeU: return 0x6a07bfe0U; break;
-    case 0x200efU: return 0x14b24336U; break;
-    case 0x200f0U: return 0xffa3e15cU; break;
-    case 0x200f1U: return 0xae7005fdU; break;
-    case 0x200f2U: return 0xa0d2980bU; break;
-    case 0x200f3U: return 0x9a9ecc02U; break;
-    case 0x200f4U: return 0x674ad295U; break;
-    case 0x200f5U: return 0xa605aed0U; break;
-    case 0x200f6U: return 0xec3cf41eU; break;
-    case 0x200f7U: return 0x64694bf5U; break;
-    case 0x200f8U: return 0xcd14aefbU; break;
-    case 0x200f9U: return 0x707b19b1U; break;
-    case 0x200faU: return 0x6f326203U; break;
-    case 0x200fbU: return 0xd480ce13U; break;
-    case 0x200fcU: return 0xeb59bf59U; break;
-    case 0x200fdU: return 0xa7c419a1U; break;
-    case 0x200feU: return 0xfb3a5e11U; break;
-    case 0x200ffU: return 0xae15db89U; break;
-    case 0x20100U: return 0x214e7ca2U; break;
-    case 0x20101U: return 0x85a90a36U; break;
-    case 0x20102U: return 0x29e721d8U; break;
-    case 0x20103U: return 0x2f1045ddU; break;
-    case 0x20104U: return 0xc9d01839U; break;
-    case 0x20105U: return 0x2c272e0aU; break;
-    case 0x20106U: return 0xa236da91U; break;
-    case 0x20107U: return 0x9d46a4bcU; break;
-    case 0x20108U: return 0x3a3d6a9eU; break;
-    case 0x20109U: return 0x5471c523U; break;
-    case 0x2010aU: return 0x5add8541U; break;
-    case 0x2010bU: return 0x49c0649dU; break;
-    case 0x2010cU: return 0x88973990U; break;
-    case 0x2010dU: return 0x187ac70eU; break;
-    case 0x2010eU: return 0x3456552cU; break;
-    case 0x2010fU: return 0x5cf7fd13U; break;
-    case 0x20110U: return 0x8da39981U; break;
-    case 0x20111U: return 0xeafdb1eeU; break;
-    case 0x20112U: return 0xf517258bU; break;
-    case 0x20113U: return 0xcb4c9c9cU; break;
-    case 0x20114U: return 0x23524aa6U; break;
-    case 0x20115U: return 0xbf86bd03U; break;
-    case 0x20116U: return 0x3defb16cU; break;
-    case 0x20117U: return 0xc40191abU; break;
-    case 0x20118U: return 0x2ef653b7U; break;
-    case 0x20119U: return 0x84bf1cc3U; break;
-    case 0x2011aU: return 0x1fa1c562U; break;
-    case 0x2011bU: return 0xa0d3a285U; break;
-    case 0x2011cU: return 0x39f56febU; break;
-    case 0x2011dU: return 0x8036bcd1U; break;
-    case 0x2011eU: return 0x209dfc7bU; break;
-    case 0x2011fU: return 0xd1c65811U; break;
-    case 0x20120U: return 0xd50c53b8U; break;
-    case 0x20121U: return 0x12fa4be9U; break;
-    case 0x20122U: return 0xa8d4c09aU; break;
-    case 0x20123U: return 0x7a6f0d00U; break;
-    case 0x20124U: return 0x68537c3cU; break;
-    case 0x20125U: return 0xd75a0b31U; break;
-    case 0x20126U: return 0xc92900bdU; break;
-    case 0x20127U: return 0x51c9ffb6U; break;
-    case 0x20128U: return 0x7eba8d3fU; break;
-    case 0x20129U: return 0x33b01dc8U; break;
-    case 0x2012aU: return 0xd5c596e4U; break;
-    case 0x2012bU: return 0x217adeccU; break;
-    case 0x2012cU: return 0x6cd0ce4eU; break;
-    case 0x2012dU: return 0x318f8ffeU; break;
-    case 0x2012eU: return 0x70fd1946U; break;
-    case 0x2012fU: return 0x541ad8ceU; break;
-    case 0x20130U: return 0x78645836U; break;
-    case 0x20131U: return 0x4e28c4a2U; break;
-    case 0x20132U: return 0xe95d2cccU; break;
-    case 0x20133U: return 0xbda94b63U; break;
-    case 0x20134U: return 0xd4baac80U; break;
-    case 0x20135U: return 0x7d5e72a0U; break;
-    case 0x20136U: return 0xdcdb3e26U; break;
-    case 0x20137U: return 0xa6dcd84bU; break;
-    case 0x20138U: return 0xd31f2c35U; break;
-    case 0x20139U: return 0x50018d44U; break;
-    case 0x2013aU: return 0x1b90f1aeU; break;
-    case 0x2013bU: return 0xc404a599U; break;
-    case 0x2013cU: return 0x4d24e447U; break;
-    case 0x2013dU: return 0xd7ae2a23U; break;
-    case 0x2013eU: return 0xa5b40738U; break;
-    case 0x2013fU: return 0x148b3996U; break;
-    case 0x20140U: return 0xf6f06f32U; break;
-    case 0x20141U: return 0x45630a2bU; break;
-    case 0x20142U: return 0x38521ef2U; break;
-    case 0x20143U: return 0x34c1f07dU; break;
-    case 0x20144U: return 0x8939b5d7U; break;
-    case 0x20145U: return 0x55093b60U; break;
-    case 0x20146U: return 0xe14f92f3U; break;
-    case 0x20147U: return 0x678b1e6eU; break;
-    case 0x20148U: return 0xeb2ab530U; break;
-    case 0x20149U: return 0xc4e20f08U; break;
-    case 0x2014aU: return 0xda5f6b84U; break;
-    case 0x2014bU: return 0x8ed3374dU; break;
-    case 0x2014cU: return 0xfb4166dbU; break;
-    case 0x2014dU: return 0x458fd294U; break;
-    case 0x2014eU: return 0xf1b49fb2U; break;
-    case 0x2014fU: return 0x55617653U; break;
-    case 0x20150U: return 0x28e7bac2U; break;
-    case 0x20151U: return 0x54bfa5ceU; break;
-    case 0x20152U: return 0x481102a9U; break;
-    case 0x20153U: return 0x9419fc9eU; break;
-    case 0x20154U: return 0xee1a5f42U; break;
-    case 0x20155U: return 0x20781d49U; break;
-    case 0x20156U: return 0x65bceab8U; break;
-    case 0x20157U: return 0xe5f3fed0U; break;
-    case 0x20158U: return 0x821f0dfeU; break;
-    case 0x20159U: return 0xba94d544U; break;
-    case 0x2015aU: return 0x1d62bcefU; break;
-    case 0x2015bU: return 0xfb24fcc8U; break;
-    case 0x2015cU: return 0xdee1ebdeU; break;
-    case 0x2015dU: return 0xca964c53U; break;
-    case 0x2015eU: return 0xfc6230bfU; break;
-    case 0x2015fU: return 0x47e986cbU; break;
-    case 0x20160U: return 0x9144e30fU; break;
-    case 0x20161U: return 0xce829412U; break;
-    case 0x20162U: return 0xa0411b5dU; break;
-    case 0x20163U: return 0x81e1dd20U; break;
-    case 0x20164U: return 0x6a4b7bc2U; break;
-    case 0x20165U: return 0x5bfc3fd1U; break;
-    case 0x20166U: return 0x42785d63U; break;
-    case 0x20167U: return 0xb0b41747U; break;
-    case 0x20168U: return 0x42f9efb8U; break;
-    default: assert(false);
-  }
+constexpr uint64 zobrist_side_hash(Player player){
+  return player == Player::White ? ZOBRIST_WHITE_TO_MOVE_KEY : 0ULL;
 }
 
-constexpr uint EMPTY_BOARD = 0U;
+constexpr uint64 EMPTY_BOARD = 0ULL;
 
 } //rlgames
 #endif//RLGAMES_ZOBRIST_HASH
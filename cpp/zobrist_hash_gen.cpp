@@ -11,11 +11,17 @@
 namespace s = std;
 namespace R = rlgames;
 
-// generate perfect hash for each player point combination
+// generate 64 bit zobrist keys: one per player point combination, one per ko
+// point and one for the side to move. keys are indexed by point index, one
+// table of MAX_SIZE * MAX_SIZE points serves every board size up to MAX_SIZE
+
+constexpr uint MAX_SIZE = 19;
+constexpr uint MAX_POINTS = MAX_SIZE * MAX_SIZE;
+constexpr uint KEYS_PER_LINE = 4;
 
 namespace {
-std::default_random_engine& get_default_random_engine(){
-  static std::default_random_engine engine(time(0));
+s::mt19937_64& get_random_engine(){
+  static s::mt19937_64 engine(time(0));
   return engine;
 }
 } //namespace
@@ -33,50 +39,79 @@ void generate_file_include(s::fstream& out){
   out << "\n";
 }
 
-unsigned get_next_value(s::uniform_int_distribution<unsigned>& dist, s::unordered_set<unsigned>& used){
-  unsigned value = dist(get_default_random_engine());
+uint64 get_next_value(s::uniform_int_distribution<uint64>& dist, s::unordered_set<uint64>& used){
+  uint64 value = dist(get_random_engine());
   while (used.find(value) != used.end()){
-    value = dist(get_default_random_engine());
+    value = dist(get_random_engine());
   }
+  used.insert(value);
   return value;
 }
 
+void generate_key_list(s::fstream& out, uint count, const char* indent, s::uniform_int_distribution<uint64>& dist, s::unordered_set<uint64>& used){
+  for (uint i = 0; i < count; ++i){
+    if (i % KEYS_PER_LINE == 0) out << indent;
+    out << "0x" << get_next_value(dist, used) << "ULL";
+    if (i + 1 < count) out << ",";
+    bool line_end = i % KEYS_PER_LINE == KEYS_PER_LINE - 1 || i + 1 == count;
+    if (line_end) out << "\n";
+    else          out << " ";
+  }
+}
+
 void generate_hash_table(s::fstream& out){
-  s::uniform_int_distribution<uint> dist(0x10000000U, 0xFFFFFFFFU);
-  s::unordered_set<uint> used;
+  s::uniform_int_distribution<uint64> dist(0x1000000000000000ULL, 0xFFFFFFFFFFFFFFFFULL);
+  s::unordered_set<uint64> used;
 
-  out << "template <size_t SZ>\n";
-  out << "uint zobrist_hash(Player player, Pt pt){\n";
-  out << "  assert(player != Player::Unknown);\n";
+  out << "constexpr uint ZOBRIST_MAX_SIZE = " << MAX_SIZE << ";\n";
   out << "\n";
-  out << "  uint key = index<SZ>(pt);\n";
-  out << "  key |= (uint)player << 16;\n";
-  out << "  switch (key){\n";
-
   out << std::hex;
-  for (uint i = 0; i < 19 * 19; ++i){
-    uint value = ((uint)R::Player::Black) << 16U;
-    value |= i;
-    uint hash_value = get_next_value(dist, used);
-    used.insert(hash_value);
-  out << "    case 0x" << value << "U: return 0x" << hash_value << "U; break;\n";
-  }
-  for (uint i = 0; i < 19 * 19; ++i){
-    uint value = ((uint)R::Player::White) << 16U;
-    value |= i;
-    uint hash_value = get_next_value(dist, used);
-    used.insert(hash_value);
-  out << "    case 0x" << value << "U: return 0x" << hash_value << "U; break;\n";
-  }
-  out << "    default: assert(false);\n";
 
-  out << "  }\n";
+  out << "//stone keys indexed by [player - 1][point index]\n";
+  out << "constexpr uint64 ZOBRIST_STONE_KEYS[2][ZOBRIST_MAX_SIZE * ZOBRIST_MAX_SIZE] = {\n";
+  out << "  {\n";
+  generate_key_list(out, MAX_POINTS, "    ", dist, used);
+  out << "  },\n";
+  out << "  {\n";
+  generate_key_list(out, MAX_POINTS, "    ", dist, used);
+  out << "  },\n";
+  out << "};\n";
+  out << "\n";
+
+  out << "//ko point keys indexed by point index\n";
+  out << "constexpr uint64 ZOBRIST_KO_KEYS[ZOBRIST_MAX_SIZE * ZOBRIST_MAX_SIZE] = {\n";
+  generate_key_list(out, MAX_POINTS, "  ", dist, used);
+  out << "};\n";
+  out << "\n";
+
+  out << "//side to move key, present when white is to move\n";
+  out << "constexpr uint64 ZOBRIST_WHITE_TO_MOVE_KEY = 0x" << get_next_value(dist, used) << "ULL;\n";
+  out << "\n";
+  out << std::dec;
+
+  out << "template <size_t SZ>\n";
+  out << "uint64 zobrist_hash(Player player, Pt pt){\n";
+  out << "  static_assert(SZ <= ZOBRIST_MAX_SIZE, \"no zobrist keys for board size\");\n";
+  out << "  assert(player == Player::Black || player == Player::White);\n";
+  out << "\n";
+  out << "  return ZOBRIST_STONE_KEYS[(uint)player - 1][index<SZ>(pt)];\n";
+  out << "}\n";
+  out << "\n";
+  out << "template <size_t SZ>\n";
+  out << "uint64 zobrist_ko_hash(Pt pt){\n";
+  out << "  static_assert(SZ <= ZOBRIST_MAX_SIZE, \"no zobrist keys for board size\");\n";
+  out << "\n";
+  out << "  return ZOBRIST_KO_KEYS[index<SZ>(pt)];\n";
+  out << "}\n";
+  out << "\n";
+  out << "constexpr uint64 zobrist_side_hash(Player player){\n";
+  out << "  return player == Player::White ? ZOBRIST_WHITE_TO_MOVE_KEY : 0ULL;\n";
   out << "}\n";
 }
 
 void generate_file_suffix(s::fstream& out){
   out << "\n";
-  out << "constexpr uint EMPTY_BOARD = 0U;\n";
+  out << "constexpr uint64 EMPTY_BOARD = 0ULL;\n";
   out << "\n";
   out << "} //rlgames\n";
   out << "#endif//RLGAMES_ZOBRIST_HASH\n";